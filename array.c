@@ -1,18 +1,51 @@
 #include <stdio.h>
-#include <conio.h>
+#include "fast_io.h"
+#ifdef BATCH_IO
+#include "dataset.h"
+#endif
 
-void main() {
-    int arr[5], i;
-    clrscr();
-    
-    printf("Enter 5 elements: ");
-    for(i = 0; i < 5; i++) {
-        scanf("%d", &arr[i]);
+// With -DBATCH_IO the elements can also come from an int32 dataset file
+// (see dataset.h) named on the command line, read straight from the
+// mapping instead of parsed from text:
+//     ./a.out numbers.ds > out.txt
+
+void printElements(const int *a, size_t n) {
+    size_t i;
+    writeStr("Array elements are: ");
+    for(i = 0; i < n; i++) {
+        writeInt(a[i]);
+        writeChar(' ');
     }
-    
-    printf("Array elements are: ");
-    for(i = 0; i < 5; i++) {
-        printf("%d ", arr[i]);
+}
+
+void fromDataset(const char *file) {
+#ifdef BATCH_IO
+    struct Dataset ds;
+    const int *a;
+    int *copy;
+    int rc = datasetOpen(&ds, file, 0);
+    if(rc == DS_OK) {
+        rc = datasetInts(&ds, &a, &copy);
+        if(rc == DS_OK) printElements(a, (size_t)ds.count);
+        free(copy);
+        datasetClose(&ds);
     }
-    getch();
+    if(rc != DS_OK) { writeStr(file); writeStr(": "); writeStr(datasetError(rc)); writeChar('\n'); }
+#else
+    (void)file;
+    writeStr("Dataset files need a -DBATCH_IO build\n");
+#endif
+}
+
+void main(int argc, char **argv) {
+    int arr[5];
+    startIO();
+    
+    if(argc > 1) { fromDataset(argv[1]); endIO(); return; }
+    
+    prompt("Enter 5 elements: ");
+    if(!readInts(arr, 5)) { writeStr("Invalid input\n"); endIO(); return; }
+    
+    printElements(arr, 5);
+    endIO();
 }
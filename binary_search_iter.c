@@ -1,19 +1,21 @@
 #include <stdio.h>
-#include <conio.h>
+#include <stdlib.h>
+#include "fast_io.h"
 
 void main() {
-    int arr[10], n, i, key, low, high, mid, found=0;
-    clrscr();
+    int *arr, n, key, low, high, mid, found=0;
+    startIO();
     
-    printf("Enter number of elements (sorted): ");
-    scanf("%d",&n);
+    prompt("Enter number of elements (sorted): ");
+    if(!readInt(&n) || n < 0) { writeStr("Invalid input\n"); endIO(); return; }
+    arr = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if(arr == NULL) { writeStr("Out of memory\n"); endIO(); return; }
     
-    printf("Enter sorted elements: ");
-    for(i=0;i<n;i++)
-        scanf("%d",&arr[i]);
+    prompt("Enter sorted elements: ");
+    if(!readInts(arr, n)) { writeStr("Invalid input\n"); free(arr); endIO(); return; }
     
-    printf("Enter element to search: ");
-    scanf("%d",&key);
+    prompt("Enter element to search: ");
+    if(!readInt(&key)) { writeStr("Invalid input\n"); free(arr); endIO(); return; }
     
     low=0; high=n-1;
     while(low<=high) {
@@ -23,9 +25,12 @@ void main() {
         else high=mid-1;
     }
     
-    if(found)
-        printf("Element found at position %d", mid+1);
+    if(found) {
+        writeStr("Element found at position ");
+        writeInt(mid+1);
+    }
     else
-        printf("Element not found");
-    getch();
+        writeStr("Element not found");
+    free(arr);
+    endIO();
 }
@@ -1,5 +1,6 @@
 #include <stdio.h>
-#include <conio.h>
+#include <stdlib.h>
+#include "fast_io.h"
 
 int binarySearch(int arr[], int low, int high, int key) {
     int mid;
@@ -11,22 +12,24 @@ int binarySearch(int arr[], int low, int high, int key) {
 }
 
 void main() {
-    int arr[10], n, i, key, result;
-    clrscr();
+    int *arr, n, key, result;
+    startIO();
     
-    printf("Enter number of elements (sorted): ");
-    scanf("%d",&n);
+    prompt("Enter number of elements (sorted): ");
+    if(!readInt(&n) || n < 0) { writeStr("Invalid input\n"); endIO(); return; }
+    arr = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if(arr == NULL) { writeStr("Out of memory\n"); endIO(); return; }
     
-    printf("Enter sorted elements: ");
-    for(i=0;i<n;i++)
-        scanf("%d",&arr[i]);
+    prompt("Enter sorted elements: ");
+    if(!readInts(arr, n)) { writeStr("Invalid input\n"); free(arr); endIO(); return; }
     
-    printf("Enter element to search: ");
-    scanf("%d",&key);
+    prompt("Enter element to search: ");
+    if(!readInt(&key)) { writeStr("Invalid input\n"); free(arr); endIO(); return; }
     
     result=binarySearch(arr,0,n-1,key);
-    if(result!=-1) printf("Element found at position %d", result+1);
-    else printf("Element not found");
+    if(result!=-1) { writeStr("Element found at position "); writeInt(result+1); }
+    else writeStr("Element not found");
     
-    getch();
+    free(arr);
+    endIO();
 }
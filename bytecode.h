@@ -0,0 +1,23 @@
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+// Postfix bytecode shared by infix_compiler.c, postfix_columnar.c and
+// expression_cache.c.
+//
+// One 64-bit word per postfix token: the opcode in the low 8 bits and a
+// signed 56-bit argument above it (the literal value, or a variable or
+// temporary index). A literal outside CODE_ARG_MIN .. CODE_ARG_MAX does
+// not fit in a word, so producers must reject it or, for a folded
+// constant, keep the expression unfolded (check with CODE_FITS).
+// OP_STORE and OP_LOAD are only produced by expression_cache.c.
+
+enum { OP_NUM, OP_VAR, OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW, OP_NEG, OP_STORE, OP_LOAD, OP_COUNT };
+
+#define CODE(op, arg) ((long long)((unsigned long long)(arg) << 8) | (op))
+#define CODE_OP(w) ((int)((w) & 0xFF))
+#define CODE_ARG(w) ((w) >> 8)
+#define CODE_ARG_MAX ((1LL << 55) - 1)
+#define CODE_ARG_MIN (-(1LL << 55))
+#define CODE_FITS(v) ((v) >= CODE_ARG_MIN && (v) <= CODE_ARG_MAX)
+
+#endif
@@ -0,0 +1,254 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Graph in compressed sparse row (CSR) form, built from an edge list.
+//
+// The neighbours of vertex u are adj[offsets[u]] .. adj[offsets[u+1]-1],
+// so a vertex expansion reads one contiguous run instead of a row of V
+// entries of an adjacency matrix, and the whole graph takes
+// 8(V+1) + 4E bytes.
+//
+// graphBuild() uses two counting-sort passes, first by target and then
+// by source, so every adjacency list comes out sorted with no comparison
+// sort; duplicates and self loops are then dropped in one sweep. The
+// build is O(V + E). An undirected graph stores each edge in both
+// directions; for a directed one, GRAPH_TRANSPOSE builds the in-edges
+// (needed by bottom-up BFS steps). graphRelabel() renames the vertices
+// by a permutation, for the orderings in graph_reorder.c.
+//
+// Vertex ids are 32-bit, so up to 2^31 - 1 vertices (room is left for -1
+// as "none" in int32 parent arrays); edge offsets are 64-bit.
+
+#define GRAPH_UNDIRECTED 1
+#define GRAPH_TRANSPOSE  2
+
+struct EdgeList {
+    uint32_t n;                // vertices: one more than the largest id
+    uint64_t m, cap;
+    uint32_t *src, *dst;
+};
+
+struct Graph {
+    uint32_t n;
+    uint64_t m;                // stored (directed) edges
+    uint64_t *offsets;         // n + 1 entries
+    uint32_t *adj;             // m entries, each list sorted
+};
+
+static inline uint64_t graphDegree(const struct Graph *g, uint32_t u) {
+    return g->offsets[u + 1] - g->offsets[u];
+}
+
+static inline void edgeListFree(struct EdgeList *el) {
+    free(el->src);
+    free(el->dst);
+    memset(el, 0, sizeof(*el));
+}
+
+static inline void graphFree(struct Graph *g) {
+    free(g->offsets);
+    free(g->adj);
+    memset(g, 0, sizeof(*g));
+}
+
+static inline int edgeListAdd(struct EdgeList *el, uint32_t u, uint32_t v) {
+    if (el->m == el->cap) {
+        uint64_t cap = el->cap ? el->cap * 2 : 1024;
+        uint32_t *s = (uint32_t*)realloc(el->src, cap * sizeof(uint32_t));
+        uint32_t *d = s ? (uint32_t*)realloc(el->dst, cap * sizeof(uint32_t)) : NULL;
+        if (s) el->src = s;
+        if (d == NULL) return 0;
+        el->dst = d;
+        el->cap = cap;
+    }
+    el->src[el->m] = u;
+    el->dst[el->m++] = v;
+    if (u >= el->n) el->n = u + 1;
+    if (v >= el->n) el->n = v + 1;
+    return 1;
+}
+
+static inline uint64_t graphRandom(uint64_t *state) {   // splitmix64
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// R-MAT (Kronecker) generator with the Graph500 parameters: 2^scale
+// vertices, edgeFactor * 2^scale edges, skewed power-law degrees. Vertex
+// ids are randomly permuted afterwards so that ids carry no locality.
+static inline int edgeListRmat(struct EdgeList *el, int scale, int edgeFactor, uint64_t seed) {
+    const uint32_t A = 2448131229u, AB = 3264175145u, ABC = 4080218931u;   // 0.57, 0.76, 0.95 of 2^32
+    uint64_t m = (uint64_t)edgeFactor << scale, e, state = seed;
+    uint32_t n = 1u << scale, *perm, u, v, r, t, i;
+    int bit;
+    memset(el, 0, sizeof(*el));
+    if (scale < 1 || scale > 30 || edgeFactor < 1) return 0;
+    el->src = (uint32_t*)malloc(m * sizeof(uint32_t));
+    el->dst = (uint32_t*)malloc(m * sizeof(uint32_t));
+    perm = (uint32_t*)malloc((uint64_t)n * sizeof(uint32_t));
+    if (el->src == NULL || el->dst == NULL || perm == NULL) { edgeListFree(el); free(perm); return 0; }
+    for (i = 0; i < n; i++) perm[i] = i;
+    for (i = n - 1; i > 0; i--) {
+        r = (uint32_t)(graphRandom(&state) % (i + 1));
+        t = perm[i]; perm[i] = perm[r]; perm[r] = t;
+    }
+    for (e = 0; e < m; e++) {
+        u = v = 0;
+        for (bit = 0; bit < scale; bit++) {
+            r = (uint32_t)graphRandom(&state);
+            if (r >= ABC) { u |= 1u << bit; v |= 1u << bit; }
+            else if (r >= AB) u |= 1u << bit;
+            else if (r >= A) v |= 1u << bit;
+        }
+        el->src[e] = perm[u];
+        el->dst[e] = perm[v];
+    }
+    free(perm);
+    el->n = n;
+    el->m = el->cap = m;
+    return 1;
+}
+
+// Text edge list: one "u v" pair per line, lines starting with '#' or '%'
+// are comments. The file is mapped rather than read with fscanf.
+static inline int edgeListLoad(struct EdgeList *el, const char *path) {
+    struct stat st;
+    const char *base, *p, *end;
+    uint64_t x[2];
+    int fd = open(path, O_RDONLY), k;
+    memset(el, 0, sizeof(*el));
+    if (fd < 0) return 0;
+    if (fstat(fd, &st) != 0) { close(fd); return 0; }
+    if (st.st_size == 0) { close(fd); return 1; }
+    base = p = (const char*)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return 0;
+    madvise((void*)base, st.st_size, MADV_SEQUENTIAL);
+    end = base + st.st_size;
+    while (p < end) {
+        if (*p == '#' || *p == '%') {
+            while (p < end && *p != '\n') p++;
+        }
+        else {
+            for (k = 0; k < 2; k++) {
+                while (p < end && *p != '\n' && (unsigned)(*p - '0') >= 10) p++;
+                if (p == end || *p == '\n') break;
+                for (x[k] = 0; p < end && (unsigned)(*p - '0') < 10; p++) x[k] = x[k] * 10 + (*p - '0');
+            }
+            if (k == 2 && x[0] < INT32_MAX && x[1] < INT32_MAX
+                && !edgeListAdd(el, (uint32_t)x[0], (uint32_t)x[1])) break;
+            while (p < end && *p != '\n') p++;
+        }
+        p++;
+    }
+    munmap((void*)base, st.st_size);
+    return p >= end;
+}
+
+// Build g from el. flags: GRAPH_UNDIRECTED stores both directions,
+// GRAPH_TRANSPOSE reverses every edge. Returns 0 if out of memory.
+static inline int graphBuild(struct Graph *g, const struct EdgeList *el, int flags) {
+    uint32_t n = el->n, u, v, *bySrc;
+    uint64_t total = el->m * ((flags & GRAPH_UNDIRECTED) ? 2 : 1), *groupEnd, *pos, e, i, w;
+    int64_t prev;
+    memset(g, 0, sizeof(*g));
+    groupEnd = (uint64_t*)calloc((uint64_t)n + 1, sizeof(uint64_t));
+    pos = (uint64_t*)calloc((uint64_t)n + 1, sizeof(uint64_t));
+    bySrc = (uint32_t*)malloc((total ? total : 1) * sizeof(uint32_t));
+    g->adj = (uint32_t*)malloc((total ? total : 1) * sizeof(uint32_t));
+    if (groupEnd == NULL || pos == NULL || bySrc == NULL || g->adj == NULL) {
+        free(groupEnd); free(pos); free(bySrc); free(g->adj);
+        g->adj = NULL;
+        return 0;
+    }
+
+    // Pass 1: sources grouped by target
+    for (e = 0; e < el->m; e++) {
+        groupEnd[((flags & GRAPH_TRANSPOSE) ? el->src[e] : el->dst[e]) + 1]++;
+        if (flags & GRAPH_UNDIRECTED) groupEnd[((flags & GRAPH_TRANSPOSE) ? el->dst[e] : el->src[e]) + 1]++;
+    }
+    for (v = 0; v < n; v++) groupEnd[v + 1] += groupEnd[v];
+    for (e = 0; e < el->m; e++) {
+        u = el->src[e]; v = el->dst[e];
+        if (flags & GRAPH_TRANSPOSE) { uint32_t t = u; u = v; v = t; }
+        bySrc[groupEnd[v]++] = u;
+        if (flags & GRAPH_UNDIRECTED) bySrc[groupEnd[u]++] = v;
+    }
+    // groupEnd[v] is now the end of group v, i.e. the start of group v+1
+
+    // Pass 2: scatter by source, visiting targets in increasing order, so
+    // each adjacency list is filled already sorted
+    for (i = 0; i < total; i++) pos[bySrc[i] + 1]++;
+    for (u = 0; u < n; u++) pos[u + 1] += pos[u];
+    for (v = 0, i = 0; v < n; v++)
+        for (; i < groupEnd[v]; i++) g->adj[pos[bySrc[i]]++] = v;
+    free(bySrc);
+    free(groupEnd);
+
+    // pos[u] is now the end of list u; compact away duplicates and loops
+    g->offsets = pos;
+    for (u = 0, i = 0, w = 0; u < n; u++) {
+        uint64_t stop = pos[u];
+        pos[u] = w;
+        for (prev = -1; i < stop; i++) {
+            v = g->adj[i];
+            if ((int64_t)v != prev && v != u) g->adj[w++] = v;
+            prev = v;
+        }
+    }
+    pos[n] = w;
+    g->n = n;
+    g->m = w;
+    if (w) {
+        uint32_t *shrunk = (uint32_t*)realloc(g->adj, w * sizeof(uint32_t));
+        if (shrunk) g->adj = shrunk;
+    }
+    return 1;
+}
+
+static inline int graphCompareIds(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+// Copy of g with vertex u renamed newId[u] (newId must be a permutation
+// of 0..n-1). Lists are re-sorted: insertion sort for short ones, qsort
+// for the rest. Returns 0 if out of memory.
+static inline int graphRelabel(struct Graph *h, const struct Graph *g, const uint32_t *newId) {
+    uint64_t e, i, j, len, at;
+    uint32_t u, x, *list;
+    memset(h, 0, sizeof(*h));
+    h->offsets = (uint64_t*)calloc((uint64_t)g->n + 1, sizeof(uint64_t));
+    h->adj = (uint32_t*)malloc((g->m ? g->m : 1) * sizeof(uint32_t));
+    if (h->offsets == NULL || h->adj == NULL) { graphFree(h); return 0; }
+    for (u = 0; u < g->n; u++) h->offsets[newId[u] + 1] = graphDegree(g, u);
+    for (u = 0; u < g->n; u++) h->offsets[u + 1] += h->offsets[u];
+    for (u = 0; u < g->n; u++) {
+        at = h->offsets[newId[u]];
+        list = h->adj + at;
+        len = graphDegree(g, u);
+        for (e = 0; e < len; e++) list[e] = newId[g->adj[g->offsets[u] + e]];
+        if (len > 16) qsort(list, len, sizeof(uint32_t), graphCompareIds);
+        else
+            for (i = 1; i < len; i++) {
+                for (x = list[i], j = i; j > 0 && list[j - 1] > x; j--) list[j] = list[j - 1];
+                list[j] = x;
+            }
+    }
+    h->n = g->n;
+    h->m = g->m;
+    return 1;
+}
+
+#endif
@@ -1,17 +1,21 @@
 #include <stdio.h>
-#include <conio.h>
+#include "fast_io.h"
 
 void main() {
     int a;
     char name[20];
-    clrscr();
+    startIO();
     
-    printf("Enter an integer: ");
-    scanf("%d", &a);
+    prompt("Enter an integer: ");
+    if(!readInt(&a)) { writeStr("Invalid input\n"); endIO(); return; }
     
-    printf("Enter your name: ");
-    scanf("%s", name);
+    prompt("Enter your name: ");
+    if(!readToken(name, 20)) { writeStr("Invalid input\n"); endIO(); return; }
     
-    printf("You entered: %d and %s\n", a, name);
-    getch();
+    writeStr("You entered: ");
+    writeInt(a);
+    writeStr(" and ");
+    writeStr(name);
+    writeChar('\n');
+    endIO();
 }
@@ -0,0 +1,308 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Binary container for arrays and matrices, loaded with mmap (POSIX).
+//
+// File layout:
+//   bytes 0..127       struct DatasetHeader
+//   up to DS_ALIGN     zero padding
+//   dataOffset..       raw elements, dims[0] * .. * dims[rank-1] of them
+//
+// The data starts on a page boundary, so the mapped pointer is aligned
+// for any element type or vector load. Opening a file maps it and checks
+// only the header (magic, version, byte order, header checksum, sizes);
+// no element is read, so a 10 GB matrix is ready as soon as mmap returns
+// and its pages come in from disk when they are first touched. The data
+// checksum is checked separately by datasetVerify(), which has to read
+// everything.
+//
+// dims[] is always the logical shape (rows, cols, ...). layout says how
+// the elements are stored: row-major (last index varies fastest) or
+// column-major (first index varies fastest).
+//
+// A writer creates the file at its full size (sparse, so this is quick),
+// fills ds.data through the mapping and calls datasetClose(), which
+// computes the checksums and syncs the file. Until then the header
+// carries DS_DIRTY, so a file left by a crashed writer is reported as
+// unfinished instead of failing its checksum.
+
+#define DS_MAGIC      "DSARRAY"
+#define DS_VERSION    1
+#define DS_BYTE_ORDER 0x01020304u
+#define DS_MAX_RANK   4
+#define DS_ALIGN      4096
+
+enum { DS_INT32, DS_INT64, DS_FLOAT32, DS_FLOAT64, DS_TYPES };
+enum { DS_ROW_MAJOR, DS_COL_MAJOR };
+#define DS_DIRTY 1u   // header flag: writer has not finished
+
+enum {
+    DS_OK = 0, DS_ERR_IO = -1, DS_ERR_FORMAT = -2, DS_ERR_HEADER = -3,
+    DS_ERR_SIZE = -4, DS_ERR_ARG = -5, DS_ERR_DIRTY = -6, DS_ERR_CHECKSUM = -7,
+    DS_ERR_MEMORY = -8
+};
+
+struct DatasetHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;       // DS_BYTE_ORDER as written by the creator
+    uint32_t type;            // DS_INT32 ..
+    uint32_t rank;            // 1 .. DS_MAX_RANK
+    uint32_t layout;          // DS_ROW_MAJOR or DS_COL_MAJOR
+    uint32_t flags;
+    uint64_t dims[DS_MAX_RANK];   // unused trailing dims are 1
+    uint64_t dataOffset;
+    uint64_t dataBytes;
+    uint64_t checksum;        // of the data bytes
+    uint64_t reserved[4];
+    uint64_t headerChecksum;  // of the 120 bytes before it
+};
+
+struct Dataset {
+    struct DatasetHeader *hdr;   // points into the mapping
+    void *data;
+    uint64_t count;              // number of elements
+    size_t mapBytes;
+    int fd, writable;
+};
+
+static const int dsTypeSize[DS_TYPES] = { 4, 8, 4, 8 };
+
+static inline const char *datasetTypeName(int type) {
+    static const char *names[DS_TYPES] = { "int32", "int64", "float32", "float64" };
+    return type >= 0 && type < DS_TYPES ? names[type] : "unknown";
+}
+
+static inline const char *datasetError(int code) {
+    switch (code) {
+        case DS_OK:           return "ok";
+        case DS_ERR_IO:       return "cannot open, size or map the file";
+        case DS_ERR_FORMAT:   return "not a dataset file or unsupported version";
+        case DS_ERR_HEADER:   return "header is corrupt";
+        case DS_ERR_SIZE:     return "file is shorter than its header says";
+        case DS_ERR_ARG:      return "invalid type, rank, layout or dimensions";
+        case DS_ERR_DIRTY:    return "file was not closed by its writer";
+        case DS_ERR_CHECKSUM: return "data checksum mismatch";
+        case DS_ERR_MEMORY:   return "out of memory";
+    }
+    return "unknown error";
+}
+
+static inline uint64_t dsRotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+// 64-bit hash, four independent lanes of 8-byte words so it runs at
+// memory speed
+static inline uint64_t datasetChecksum(const void *p, uint64_t n) {
+    const uint64_t P1 = 0x9E3779B185EBCA87ULL, P2 = 0xC2B2AE3D27D4EB4FULL, P3 = 0x165667B19E3779F9ULL;
+    const unsigned char *b = (const unsigned char*)p;
+    uint64_t h[4] = { P1 + P2, P2, 0, 0 - P1 }, w, s, i = 0;
+    int k;
+    for (; i + 32 <= n; i += 32)
+        for (k = 0; k < 4; k++) {
+            memcpy(&w, b + i + 8 * k, 8);
+            h[k] = dsRotl(h[k] + w * P2, 31) * P1;
+        }
+    s = n * P3 ^ dsRotl(h[0], 1) ^ dsRotl(h[1], 7) ^ dsRotl(h[2], 12) ^ dsRotl(h[3], 18);
+    for (; i < n; i++) s = dsRotl(s ^ (b[i] * P3), 11) * P1;
+    s ^= s >> 33; s *= P2; s ^= s >> 29;
+    return s;
+}
+
+static inline uint64_t dsHeaderChecksum(const struct DatasetHeader *h) {
+    return datasetChecksum(h, offsetof(struct DatasetHeader, headerChecksum));
+}
+
+// Fills hdr->dims and hdr->dataBytes; 0 if the shape is invalid or the
+// byte count overflows
+static inline int dsSetShape(struct DatasetHeader *h, int type, int rank, const uint64_t *dims, int layout) {
+    uint64_t bytes;
+    int k;
+    if (type < 0 || type >= DS_TYPES || rank < 1 || rank > DS_MAX_RANK
+        || (layout != DS_ROW_MAJOR && layout != DS_COL_MAJOR)) return 0;
+    bytes = dsTypeSize[type];
+    for (k = 0; k < DS_MAX_RANK; k++) {
+        h->dims[k] = k < rank ? dims[k] : 1;
+        if (h->dims[k] == 0 || bytes > UINT64_MAX / h->dims[k]) return 0;
+        bytes *= h->dims[k];
+    }
+    if (bytes > UINT64_MAX - 2 * DS_ALIGN) return 0;
+    h->type = (uint32_t)type;
+    h->rank = (uint32_t)rank;
+    h->layout = (uint32_t)layout;
+    h->dataBytes = bytes;
+    return 1;
+}
+
+static inline int dsMap(struct Dataset *ds, int fd, size_t bytes, int writable) {
+    void *p = mmap(NULL, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) return 0;
+    ds->hdr = (struct DatasetHeader*)p;
+    ds->data = (char*)p + ds->hdr->dataOffset;
+    ds->mapBytes = bytes;
+    ds->fd = fd;
+    ds->writable = writable;
+    ds->count = ds->hdr->dataBytes / dsTypeSize[ds->hdr->type];
+    return 1;
+}
+
+// ---------- Writer ----------
+
+// Create (or replace) path with the given shape, mapped read-write. The
+// data is all zeros until the caller fills ds->data.
+static inline int datasetCreate(struct Dataset *ds, const char *path, int type, int rank,
+                                const uint64_t *dims, int layout) {
+    struct DatasetHeader h;
+    uint64_t total;
+    int fd;
+    memset(&h, 0, sizeof(h));
+    if (!dsSetShape(&h, type, rank, dims, layout)) return DS_ERR_ARG;
+    memcpy(h.magic, DS_MAGIC, 8);
+    h.version = DS_VERSION;
+    h.byteOrder = DS_BYTE_ORDER;
+    h.flags = DS_DIRTY;
+    h.dataOffset = DS_ALIGN;
+    total = h.dataOffset + h.dataBytes;
+    if (total != (uint64_t)(size_t)total || total != (uint64_t)(off_t)total) return DS_ERR_ARG;
+    h.headerChecksum = dsHeaderChecksum(&h);
+    fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return DS_ERR_IO;
+    if (ftruncate(fd, (off_t)total) != 0 || pwrite(fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h)
+        || !dsMap(ds, fd, (size_t)total, 1)) {
+        close(fd);
+        unlink(path);
+        return DS_ERR_IO;
+    }
+    return DS_OK;
+}
+
+// ---------- Loader ----------
+
+// Map an existing file. Only the header is read and checked.
+static inline int datasetOpen(struct Dataset *ds, const char *path, int writable) {
+    struct DatasetHeader h, shape;
+    struct stat st;
+    int fd = open(path, writable ? O_RDWR : O_RDONLY);
+    if (fd < 0) return DS_ERR_IO;
+    if (fstat(fd, &st) != 0) { close(fd); return DS_ERR_IO; }
+    if ((uint64_t)st.st_size < sizeof(h) || pread(fd, &h, sizeof(h), 0) != (ssize_t)sizeof(h)
+        || memcmp(h.magic, DS_MAGIC, 8) != 0 || h.version != DS_VERSION) { close(fd); return DS_ERR_FORMAT; }
+    memset(&shape, 0, sizeof(shape));
+    if (h.byteOrder != DS_BYTE_ORDER || h.headerChecksum != dsHeaderChecksum(&h)
+        || !dsSetShape(&shape, (int)h.type, (int)h.rank, h.dims, (int)h.layout)
+        || shape.dataBytes != h.dataBytes || memcmp(shape.dims, h.dims, sizeof(h.dims)) != 0
+        || h.dataOffset < sizeof(h) || h.dataOffset % DS_ALIGN != 0) { close(fd); return DS_ERR_HEADER; }
+    if (h.dataOffset > (uint64_t)st.st_size || h.dataBytes > (uint64_t)st.st_size - h.dataOffset) {
+        close(fd);
+        return DS_ERR_SIZE;
+    }
+    if (!dsMap(ds, fd, (size_t)st.st_size, writable)) { close(fd); return DS_ERR_IO; }
+    if (writable) {   // contents may change: checksum is redone on close
+        ds->hdr->flags |= DS_DIRTY;
+        ds->hdr->headerChecksum = dsHeaderChecksum(ds->hdr);
+    }
+    return DS_OK;
+}
+
+// Read all the data and compare with the stored checksum
+static inline int datasetVerify(const struct Dataset *ds) {
+    if (ds->hdr->flags & DS_DIRTY) return DS_ERR_DIRTY;
+    return datasetChecksum(ds->data, ds->hdr->dataBytes) == ds->hdr->checksum ? DS_OK : DS_ERR_CHECKSUM;
+}
+
+// Pass an access pattern hint (MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED)
+// for the data pages
+static inline void datasetAdvise(const struct Dataset *ds, int advice) {
+    madvise(ds->hdr, ds->mapBytes, advice);
+}
+
+// Unmap. A writable dataset is finished first: checksum, clear DS_DIRTY
+// and sync to disk.
+static inline int datasetClose(struct Dataset *ds) {
+    int rc = DS_OK;
+    if (ds->writable) {
+        ds->hdr->checksum = datasetChecksum(ds->data, ds->hdr->dataBytes);
+        ds->hdr->flags &= ~DS_DIRTY;
+        ds->hdr->headerChecksum = dsHeaderChecksum(ds->hdr);
+        if (msync(ds->hdr, ds->mapBytes, MS_SYNC) != 0) rc = DS_ERR_IO;
+    }
+    munmap(ds->hdr, ds->mapBytes);
+    close(ds->fd);
+    ds->hdr = NULL;
+    ds->data = NULL;
+    return rc;
+}
+
+// ---------- Element addressing ----------
+
+// Position in ds->data of the element with logical index idx[0..rank-1]
+static inline uint64_t datasetIndex(const struct Dataset *ds, const uint64_t *idx) {
+    const struct DatasetHeader *h = ds->hdr;
+    uint64_t pos = 0;
+    int k;
+    if (h->layout == DS_ROW_MAJOR)
+        for (k = 0; k < (int)h->rank; k++) pos = pos * h->dims[k] + idx[k];
+    else
+        for (k = (int)h->rank - 1; k >= 0; k--) pos = pos * h->dims[k] + idx[k];
+    return pos;
+}
+
+static inline uint64_t datasetIndex2(const struct Dataset *ds, uint64_t i, uint64_t j) {
+    return ds->hdr->layout == DS_ROW_MAJOR ? i * ds->hdr->dims[1] + j : j * ds->hdr->dims[0] + i;
+}
+
+// Element at position pos, converted to double whatever the stored type
+static inline double datasetGet(const struct Dataset *ds, uint64_t pos) {
+    switch (ds->hdr->type) {
+        case DS_INT32:   return ((const int32_t*)ds->data)[pos];
+        case DS_INT64:   return (double)((const int64_t*)ds->data)[pos];
+        case DS_FLOAT32: return ((const float*)ds->data)[pos];
+        default:         return ((const double*)ds->data)[pos];
+    }
+}
+
+static inline void datasetSet(struct Dataset *ds, uint64_t pos, double v) {
+    switch (ds->hdr->type) {
+        case DS_INT32:   ((int32_t*)ds->data)[pos] = (int32_t)v; break;
+        case DS_INT64:   ((int64_t*)ds->data)[pos] = (int64_t)v; break;
+        case DS_FLOAT32: ((float*)ds->data)[pos] = (float)v; break;
+        default:         ((double*)ds->data)[pos] = v;
+    }
+}
+
+// ---------- Plain int arrays ----------
+
+// Row-major ints of an int32 dataset of rank 1 or 2 (rank 1 reads as a
+// dims[0] x 1 matrix), for the array and matrix programs. A row-major
+// file is used in place (*a points into the mapping, valid until
+// datasetClose); a column-major one is transposed into *copy, which the
+// caller frees. *copy is NULL when nothing was allocated.
+static inline int datasetInts(const struct Dataset *ds, const int **a, int **copy) {
+    const int32_t *d = (const int32_t*)ds->data;
+    uint64_t i, j, r = ds->hdr->dims[0], c = ds->hdr->dims[1];
+    *copy = NULL;
+    if (ds->hdr->type != DS_INT32 || ds->hdr->rank > 2) return DS_ERR_ARG;
+    if (ds->hdr->layout == DS_ROW_MAJOR && sizeof(int) == sizeof(int32_t)) {
+        *a = (const int*)d;
+        return DS_OK;
+    }
+    *copy = (int*)malloc((ds->count ? (size_t)ds->count : 1) * sizeof(int));
+    if (*copy == NULL) return DS_ERR_MEMORY;
+    for (i = 0; i < r; i++)
+        for (j = 0; j < c; j++) (*copy)[i * c + j] = d[datasetIndex2(ds, i, j)];
+    *a = *copy;
+    return DS_OK;
+}
+
+#endif
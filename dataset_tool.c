@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "dataset.h"
+
+// Create, inspect and convert dataset files (see dataset.h). Text input
+// for the array and matrix programs can be imported once and then opened
+// with mmap instead of being parsed on every run. POSIX only (mmap), so
+// this program does not use conio.h.
+
+#define PRINT_LIMIT 20   // rows and columns shown by Print
+#define BLOCK 64         // tile size for the layout change
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int readShape(int *type, int *rank, uint64_t *dims, int *layout) {
+    int k;
+    unsigned long long d;
+    printf("Enter type (0 int32, 1 int64, 2 float32, 3 float64): ");
+    scanf("%d", type);
+    printf("Enter rank (1-%d): ", DS_MAX_RANK);
+    scanf("%d", rank);
+    if (*rank < 1 || *rank > DS_MAX_RANK) return 0;
+    printf("Enter %d dimension(s): ", *rank);
+    for (k = 0; k < *rank; k++) { scanf("%llu", &d); dims[k] = d; }
+    printf("Enter layout (0 row-major, 1 column-major): ");
+    scanf("%d", layout);
+    return 1;
+}
+
+// Step idx[] to the next logical (row-major) index; 0 after the last one
+int nextIndex(const struct DatasetHeader *h, uint64_t *idx) {
+    int k;
+    for (k = (int)h->rank - 1; k >= 0; k--) {
+        if (++idx[k] < h->dims[k]) return 1;
+        idx[k] = 0;
+    }
+    return 0;
+}
+
+void printElement(const struct Dataset *ds, uint64_t pos) {
+    switch (ds->hdr->type) {
+        case DS_INT32: printf("%d ", ((const int32_t*)ds->data)[pos]); break;
+        case DS_INT64: printf("%lld ", (long long)((const int64_t*)ds->data)[pos]); break;
+        default:       printf("%g ", datasetGet(ds, pos));
+    }
+}
+
+// Elements are read in logical row-major order whatever the layout
+void importText(const char *textPath, const char *path) {
+    struct Dataset ds;
+    uint64_t dims[DS_MAX_RANK], idx[DS_MAX_RANK] = { 0 }, pos, n = 0;
+    int type, rank, layout, rc, ok = 1;
+    long long iv;
+    double fv;
+    FILE *fp = fopen(textPath, "r");
+    if (fp == NULL) { printf("Cannot open %s", textPath); return; }
+    if (!readShape(&type, &rank, dims, &layout)) { printf("Invalid shape"); fclose(fp); return; }
+    rc = datasetCreate(&ds, path, type, rank, dims, layout);
+    if (rc != DS_OK) { printf("Error: %s", datasetError(rc)); fclose(fp); return; }
+    do {
+        pos = datasetIndex(&ds, idx);
+        if (type == DS_INT32 || type == DS_INT64) {
+            if (fscanf(fp, "%lld", &iv) != 1) { ok = 0; break; }
+            if (type == DS_INT32) ((int32_t*)ds.data)[pos] = (int32_t)iv;
+            else ((int64_t*)ds.data)[pos] = iv;
+        }
+        else {
+            if (fscanf(fp, "%lf", &fv) != 1) { ok = 0; break; }
+            datasetSet(&ds, pos, fv);
+        }
+        n++;
+    } while (nextIndex(ds.hdr, idx));
+    fclose(fp);
+    rc = datasetClose(&ds);
+    if (!ok) printf("Only %llu elements in %s, rest left as 0\n", (unsigned long long)n, textPath);
+    printf(rc == DS_OK ? "Wrote %llu elements to %s" : "Error writing %llu elements to %s", (unsigned long long)ds.count, path);
+}
+
+void generate(const char *path) {
+    struct Dataset ds;
+    uint64_t dims[DS_MAX_RANK], i, x = 88172645463325252ULL;
+    int type, rank, layout, rc;
+    double t;
+    if (!readShape(&type, &rank, dims, &layout)) { printf("Invalid shape"); return; }
+    t = now();
+    rc = datasetCreate(&ds, path, type, rank, dims, layout);
+    if (rc != DS_OK) { printf("Error: %s", datasetError(rc)); return; }
+    datasetAdvise(&ds, MADV_SEQUENTIAL);
+    for (i = 0; i < ds.count; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        switch (type) {
+            case DS_INT32: ((int32_t*)ds.data)[i] = (int32_t)(x % 1000); break;
+            case DS_INT64: ((int64_t*)ds.data)[i] = (int64_t)(x % 1000000); break;
+            default:       datasetSet(&ds, i, (x >> 11) * (1.0 / 9007199254740992.0));
+        }
+    }
+    rc = datasetClose(&ds);
+    if (rc != DS_OK) printf("Error: %s", datasetError(rc));
+    else printf("Wrote %llu elements in %.3f s", (unsigned long long)ds.count, now() - t);
+}
+
+void info(const struct Dataset *ds) {
+    const struct DatasetHeader *h = ds->hdr;
+    int k;
+    printf("Type: %s  Rank: %u  Dims:", datasetTypeName((int)h->type), h->rank);
+    for (k = 0; k < (int)h->rank; k++) printf(" %llu", (unsigned long long)h->dims[k]);
+    printf("\nLayout: %s  Data: %llu bytes at offset %llu\n", h->layout == DS_ROW_MAJOR ? "row-major" : "column-major",
+           (unsigned long long)h->dataBytes, (unsigned long long)h->dataOffset);
+    printf("Checksum: %016llx%s", (unsigned long long)h->checksum, (h->flags & DS_DIRTY) ? " (unfinished)" : "");
+}
+
+// Print the first PRINT_LIMIT rows and columns (trailing dims are shown
+// as consecutive rows)
+void printData(const struct Dataset *ds) {
+    const struct DatasetHeader *h = ds->hdr;
+    uint64_t idx[DS_MAX_RANK] = { 0 }, last = h->dims[h->rank - 1], rows = 0;
+    do {
+        printElement(ds, datasetIndex(ds, idx));
+        if (idx[h->rank - 1] == PRINT_LIMIT - 1 && last > PRINT_LIMIT) {   // skip to the end of the row
+            printf("...");
+            idx[h->rank - 1] = last - 1;
+        }
+        if (idx[h->rank - 1] == last - 1) {
+            printf("\n");
+            if (++rows == PRINT_LIMIT) { printf("..."); break; }
+        }
+    } while (nextIndex(h, idx));
+}
+
+// Write the same logical data to path with the other layout. Matrices are
+// copied in BLOCK x BLOCK tiles so both the reads and the writes stay
+// within a few pages at a time. The output must be a different file:
+// creating it truncates, which would zero the source under its mapping.
+void changeLayout(const struct Dataset *src, const char *path) {
+    const struct DatasetHeader *h = src->hdr;
+    struct Dataset dst;
+    struct stat in, out;
+    uint64_t idx[DS_MAX_RANK] = { 0 }, i, j, i0, j0, r = h->dims[0], c = h->dims[1];
+    int es = dsTypeSize[h->type], rc;
+    double t;
+    if (fstat(src->fd, &in) == 0 && stat(path, &out) == 0 && in.st_dev == out.st_dev && in.st_ino == out.st_ino) {
+        printf("Output file is the input file");
+        return;
+    }
+    t = now();
+    rc = datasetCreate(&dst, path, (int)h->type, (int)h->rank, h->dims, h->layout == DS_ROW_MAJOR ? DS_COL_MAJOR : DS_ROW_MAJOR);
+    if (rc != DS_OK) { printf("Error: %s", datasetError(rc)); return; }
+    if (h->rank == 2) {
+        for (i0 = 0; i0 < r; i0 += BLOCK)
+            for (j0 = 0; j0 < c; j0 += BLOCK)
+                for (i = i0; i < i0 + BLOCK && i < r; i++)
+                    for (j = j0; j < j0 + BLOCK && j < c; j++)
+                        if (es == 4) ((uint32_t*)dst.data)[datasetIndex2(&dst, i, j)] = ((const uint32_t*)src->data)[datasetIndex2(src, i, j)];
+                        else ((uint64_t*)dst.data)[datasetIndex2(&dst, i, j)] = ((const uint64_t*)src->data)[datasetIndex2(src, i, j)];
+    }
+    else {
+        do memcpy((char*)dst.data + datasetIndex(&dst, idx) * es, (const char*)src->data + datasetIndex(src, idx) * es, es);
+        while (nextIndex(h, idx));
+    }
+    rc = datasetClose(&dst);
+    if (rc != DS_OK) printf("Error: %s", datasetError(rc));
+    else printf("Wrote %s in %.3f s", path, now() - t);
+}
+
+int main() {
+    struct Dataset ds;
+    char path[256], other[256];
+    int choice, rc;
+    uint64_t pos;
+    double t, v;
+    do {
+        printf("\n1.Import Text 2.Generate Random 3.Info 4.Print 5.Verify 6.Change Layout 7.Time Open 8.Exit\nEnter choice: ");
+        if (scanf("%d", &choice) != 1) break;
+        if (choice >= 1 && choice <= 7) {
+            printf("Enter dataset file: ");
+            scanf("%255s", path);
+        }
+        switch (choice) {
+            case 1:
+                printf("Enter text file: ");
+                scanf("%255s", other);
+                importText(other, path);
+                break;
+            case 2:
+                generate(path);
+                break;
+            case 3:
+            case 4:
+            case 5:
+            case 6:
+                rc = datasetOpen(&ds, path, 0);
+                if (rc != DS_OK) { printf("Error: %s", datasetError(rc)); break; }
+                if (choice == 3) info(&ds);
+                else if (choice == 4) printData(&ds);
+                else if (choice == 5) {
+                    t = now();
+                    datasetAdvise(&ds, MADV_SEQUENTIAL);
+                    rc = datasetVerify(&ds);
+                    printf("%s (%.3f s)", rc == DS_OK ? "Checksum OK" : datasetError(rc), now() - t);
+                }
+                else {
+                    printf("Enter output file: ");
+                    scanf("%255s", other);
+                    changeLayout(&ds, other);
+                }
+                datasetClose(&ds);
+                break;
+            case 7:
+                t = now();
+                rc = datasetOpen(&ds, path, 0);
+                if (rc != DS_OK) { printf("Error: %s", datasetError(rc)); break; }
+                pos = ds.count / 2;
+                v = datasetGet(&ds, pos);
+                t = now() - t;
+                printf("Opened %llu elements and read element %llu (= %g) in %.1f us",
+                       (unsigned long long)ds.count, (unsigned long long)pos, v, t * 1e6);
+                datasetClose(&ds);
+                break;
+            case 8: break;
+            default: printf("Invalid choice");
+        }
+    } while (choice != 8);
+    return 0;
+}
@@ -0,0 +1,342 @@
+// Data Structure and Algorithms
+// Compact Doubly Circular Linked List (32-bit index links)
+#include <stdio.h>
+#include <stdlib.h>
+#include <conio.h>
+#include <time.h>
+
+#define NIL 0xFFFFFFFFu
+
+// 12 bytes per element instead of a 24 byte pointer node plus malloc header
+struct Node {
+	int data;
+	unsigned int next;
+	unsigned int prev;
+};
+
+struct Node *pool = NULL;	// all nodes live in one growable array
+unsigned int capacity = 0, used = 0;	// used = slots ever handed out
+unsigned int freeList = NIL;	// recycled slots, chained through next
+unsigned int head = NIL;
+int count = 0;
+
+unsigned int newNode(int item) {
+	unsigned int i;
+	if (freeList != NIL) {
+		i = freeList;
+		freeList = pool[i].next;
+	}
+	else {
+		if (used == capacity) {
+			struct Node *p;
+			capacity = capacity ? capacity * 2 : 16;
+			p = (struct Node *)realloc(pool, capacity * sizeof(struct Node));
+			if (!p) {
+				printf("\nOVERFLOW");
+				exit(1);
+			}
+			pool = p;
+		}
+		i = used++;
+	}
+	pool[i].data = item;
+	return i;
+}
+
+void releaseNode(unsigned int i) {
+	pool[i].next = freeList;
+	freeList = i;
+}
+
+// Link node n in before node at
+void linkBefore(unsigned int at, unsigned int n) {
+	unsigned int p = pool[at].prev;
+	pool[n].next = at;
+	pool[n].prev = p;
+	pool[p].next = n;
+	pool[at].prev = n;
+}
+
+int unlinkNode(unsigned int n) {
+	int val = pool[n].data;
+	if (pool[n].next == n)
+		head = NIL;
+	else {
+		pool[pool[n].prev].next = pool[n].next;
+		pool[pool[n].next].prev = pool[n].prev;
+		if (head == n)
+			head = pool[n].next;
+	}
+	releaseNode(n);
+	count--;
+	return val;
+}
+
+// Insert at beginning
+void insertFront(int item) {
+	unsigned int n = newNode(item);
+	if (head == NIL)
+		pool[n].next = pool[n].prev = n;
+	else
+		linkBefore(head, n);
+	head = n;
+	count++;
+	printf("\nNode with value %d inserted at position 1", item);
+}
+
+// Insert at end
+void insertEnd(int item) {
+	unsigned int n = newNode(item);
+	if (head == NIL) {
+		pool[n].next = pool[n].prev = n;
+		head = n;
+	}
+	else
+		linkBefore(head, n);
+	count++;
+	printf("\nNode with value %d inserted at position %d", item, count);
+}
+
+// Insert after a given position
+void insertAfter(int item, int loc) {
+	unsigned int temp, n;
+	int i;
+	if (head == NIL) {
+		if (loc > 1)
+			printf("\nCan't insert, position out of range");
+		else
+			insertFront(item);
+		return;
+	}
+	if (loc < 1 || loc > count) {
+		printf("\nCan't insert, position out of range");
+		return;
+	}
+	temp = head;
+	for (i = 1; i < loc; i++)
+		temp = pool[temp].next;
+	n = newNode(item);
+	linkBefore(pool[temp].next, n);
+	count++;
+	printf("\nNode with value %d inserted at position %d", item, loc + 1);
+}
+
+// Delete from beginning
+void deleteFront() {
+	if (head == NIL) {
+		printf("\nList is empty");
+		return;
+	}
+	printf("\nNode with value %d deleted from position 1", unlinkNode(head));
+}
+
+// Delete from end
+void deleteEnd() {
+	int pos = count;
+	if (head == NIL) {
+		printf("\nList is empty");
+		return;
+	}
+	printf("\nNode with value %d deleted from position %d", unlinkNode(pool[head].prev), pos);
+}
+
+// Delete from a given position
+void deleteValue(int loc) {
+	unsigned int temp;
+	int i;
+	if (head == NIL) {
+		printf("\nList is empty");
+		return;
+	}
+	if (loc < 1 || loc > count) {
+		printf("\nCan't delete, position out of range");
+		return;
+	}
+	temp = head;
+	for (i = 1; i < loc; i++)
+		temp = pool[temp].next;
+	printf("\nNode with value %d deleted from position %d", unlinkNode(temp), loc);
+}
+
+// Search for a value
+void search(int item) {
+	unsigned int temp = head;
+	int i = 1;
+	if (head == NIL) {
+		printf("\nEmpty List");
+		return;
+	}
+	do {
+		if (pool[temp].data == item) {
+			printf("\nItem %d found at position %d", item, i);
+			return;
+		}
+		temp = pool[temp].next;
+		i++;
+	} while (temp != head);
+	printf("\nItem %d not found", item);
+}
+
+// Display the list
+void display() {
+	unsigned int temp = head;
+	if (head == NIL) {
+		printf("\nList is empty");
+		return;
+	}
+	printf("\nDoubly Circular Linked List: ");
+	do {
+		printf("%d ", pool[temp].data);
+		temp = pool[temp].next;
+	} while (temp != head);
+	printf("\n");
+}
+
+// Renumber nodes into traversal order so a walk reads the array
+// sequentially, drop the free slots and shrink the array to fit
+void compact() {
+	struct Node *p;
+	unsigned int temp = head, i;
+	if (head == NIL) {
+		free(pool);
+		pool = NULL;
+		capacity = used = 0;
+		freeList = NIL;
+		return;
+	}
+	p = (struct Node *)malloc(count * sizeof(struct Node));
+	if (!p) {
+		printf("\nOVERFLOW");
+		return;
+	}
+	for (i = 0; i < (unsigned int)count; i++) {
+		p[i].data = pool[temp].data;
+		p[i].next = (i + 1) % count;
+		p[i].prev = (i + count - 1) % count;
+		temp = pool[temp].next;
+	}
+	free(pool);
+	pool = p;
+	capacity = used = count;
+	freeList = NIL;
+	head = 0;
+}
+
+void stats() {
+	printf("\nElements: %d, Slots: %u used / %u allocated", count, used, capacity);
+	printf("\nBytes per element: %.1f (pointer node: %d + malloc header)",
+		count ? (double)capacity * sizeof(struct Node) / count : 0.0,
+		(int)(sizeof(int) + 2 * sizeof(void *) + 4));
+}
+
+// Traversal time with nodes linked in random physical order (as after
+// long insert/delete churn), before and after compaction
+void benchmark(int n) {
+	unsigned int temp, *perm = (unsigned int *)malloc(n * sizeof(unsigned int));
+	unsigned int j, k;
+	long long sum;
+	clock_t t;
+	int i, r;
+	if (n <= 0 || !perm)
+		return;
+	for (i = 0; i < n; i++)
+		perm[i] = newNode(i);
+	for (i = n - 1; i > 0; i--) {
+		j = rand() % (i + 1);
+		k = perm[i];
+		perm[i] = perm[j];
+		perm[j] = k;
+	}
+	for (i = 0; i < n; i++) {
+		if (head == NIL) {
+			pool[perm[i]].next = pool[perm[i]].prev = perm[i];
+			head = perm[i];
+		}
+		else
+			linkBefore(head, perm[i]);
+		count++;
+	}
+	free(perm);
+	for (r = 0; r < 2; r++) {
+		t = clock();
+		sum = 0;
+		for (i = 0; i < 10; i++) {
+			temp = head;
+			do {
+				sum += pool[temp].data;
+				temp = pool[temp].next;
+			} while (temp != head);
+		}
+		printf("\n%s traversal x10: %.3f s (sum %lld)", r ? "After compaction: " : "Before compaction:",
+			(double)(clock() - t) / CLOCKS_PER_SEC, sum);
+		if (r == 0)
+			compact();
+	}
+}
+
+// Main menu
+void main() {
+	int choice, val, pos, n;
+	clrscr();
+	do {
+		printf("\n===== Compact Doubly Linked List Menu =====\n");
+		printf("1. Insert Front\n2. Insert End\n3. Insert After Position\n4. Delete Front\n5. Delete End\n6. Delete Position\n7. Search\n8. Display\n9. Compact\n10. Stats\n11. Benchmark\n12. Exit\n");
+		printf("Enter your choice: ");
+		scanf("%d", &choice);
+		switch (choice) {
+		case 1:
+			printf("Enter value: ");
+			scanf("%d", &val);
+			insertFront(val);
+			break;
+		case 2:
+			printf("Enter value: ");
+			scanf("%d", &val);
+			insertEnd(val);
+			break;
+		case 3:
+			printf("Enter value and position: ");
+			scanf("%d %d", &val, &pos);
+			insertAfter(val, pos);
+			break;
+		case 4:
+			deleteFront();
+			break;
+		case 5:
+			deleteEnd();
+			break;
+		case 6:
+			printf("Enter position to delete: ");
+			scanf("%d", &pos);
+			deleteValue(pos);
+			break;
+		case 7:
+			printf("Enter value to search: ");
+			scanf("%d", &val);
+			search(val);
+			break;
+		case 8:
+			display();
+			break;
+		case 9:
+			compact();
+			printf("\nList compacted");
+			break;
+		case 10:
+			stats();
+			break;
+		case 11:
+			printf("Enter number of elements to add: ");
+			scanf("%d", &n);
+			benchmark(n);
+			break;
+		case 12:
+			printf("Exiting...\n");
+			break;
+		default:
+			printf("Invalid choice\n");
+		}
+	} while (choice != 12);
+	free(pool);
+	getch();
+}
@@ -0,0 +1,444 @@
+// Data Structure and Algorithms
+// Circular Doubly Linked Lists with O(1) Concatenate and Splice at a Node,
+// Split at a Node and Bulk Build
+#include <stdio.h>
+#include <stdlib.h>
+#include <conio.h>
+#include <time.h>
+
+#define LISTS 4
+#define CHUNK 64	// nodes per pool refill
+
+struct Node {
+	int data;
+	struct Node *next;
+	struct Node *prev;
+};
+
+// A list handle: any number of independent lists can exist
+struct List {
+	struct Node *head;
+	int length;	// cached, kept exact by every operation
+};
+
+// Node pool: nodes are carved out of blocks and recycled through a free
+// list, so a bulk build is a single allocation and deletes never call free()
+struct Block {
+	struct Block *next;
+	struct Node nodes[1];
+};
+
+struct Block *blocks = NULL;
+struct Node *freeNodes = NULL;
+
+struct Node *allocNodes(int n) {
+	struct Block *b = (struct Block *)malloc(sizeof(struct Block) + (n - 1) * sizeof(struct Node));
+	if (!b) {
+		printf("\nOVERFLOW");
+		exit(1);
+	}
+	b->next = blocks;
+	blocks = b;
+	return b->nodes;
+}
+
+struct Node *newNode(int item) {
+	struct Node *n;
+	int i;
+	if (freeNodes == NULL) {
+		n = allocNodes(CHUNK);
+		for (i = 0; i < CHUNK; i++) {
+			n[i].next = freeNodes;
+			freeNodes = &n[i];
+		}
+	}
+	n = freeNodes;
+	freeNodes = n->next;
+	n->data = item;
+	return n;
+}
+
+void releaseNode(struct Node *n) {
+	n->next = freeNodes;
+	freeNodes = n;
+}
+
+void freePool() {
+	struct Block *b;
+	while (blocks) {
+		b = blocks;
+		blocks = b->next;
+		free(b);
+	}
+	freeNodes = NULL;
+}
+
+void listInit(struct List *l) {
+	l->head = NULL;
+	l->length = 0;
+}
+
+// Link the circular chain first..last (count nodes) in before node pos
+void linkBefore(struct Node *pos, struct Node *first, struct Node *last) {
+	struct Node *p = pos->prev;
+	p->next = first;
+	first->prev = p;
+	last->next = pos;
+	pos->prev = last;
+}
+
+// Insert at beginning
+void insertFront(struct List *l, int item) {
+	struct Node *n = newNode(item);
+	if (l->head == NULL)
+		n->next = n->prev = n;
+	else
+		linkBefore(l->head, n, n);
+	l->head = n;
+	l->length++;
+	printf("\nNode with value %d inserted at position 1", item);
+}
+
+// Insert at end: O(1), the position is the cached length
+void insertEnd(struct List *l, int item) {
+	struct Node *n = newNode(item);
+	if (l->head == NULL) {
+		n->next = n->prev = n;
+		l->head = n;
+	}
+	else
+		linkBefore(l->head, n, n);
+	l->length++;
+	printf("\nNode with value %d inserted at position %d", item, l->length);
+}
+
+// Remove node n from l and return its value
+int unlinkNode(struct List *l, struct Node *n) {
+	int val = n->data;
+	if (n->next == n)
+		l->head = NULL;
+	else {
+		n->prev->next = n->next;
+		n->next->prev = n->prev;
+		if (l->head == n)
+			l->head = n->next;
+	}
+	l->length--;
+	releaseNode(n);
+	return val;
+}
+
+// Delete from beginning
+void deleteFront(struct List *l) {
+	if (!l->head) {
+		printf("\nList is empty");
+		return;
+	}
+	printf("\nNode with value %d deleted from position 1", unlinkNode(l, l->head));
+}
+
+// Delete from end
+void deleteEnd(struct List *l) {
+	int pos;
+	if (!l->head) {
+		printf("\nList is empty");
+		return;
+	}
+	pos = l->length;
+	printf("\nNode with value %d deleted from position %d", unlinkNode(l, l->head->prev), pos);
+}
+
+// Append n values from arr to l using one allocation and one linear pass
+void listBuild(struct List *l, int *arr, int n) {
+	struct Node *nodes;
+	int i;
+	if (n <= 0)
+		return;
+	nodes = allocNodes(n);
+	for (i = 0; i < n; i++) {
+		nodes[i].data = arr[i];
+		nodes[i].next = &nodes[(i + 1) % n];
+		nodes[i].prev = &nodes[(i + n - 1) % n];
+	}
+	if (l->head == NULL)
+		l->head = nodes;
+	else
+		linkBefore(l->head, nodes, &nodes[n - 1]);
+	l->length += n;
+}
+
+// Move all of b to the end of a in O(1)
+void listConcat(struct List *a, struct List *b) {
+	if (b->head == NULL)
+		return;
+	if (a->head == NULL)
+		a->head = b->head;
+	else
+		linkBefore(a->head, b->head, b->head->prev);
+	a->length += b->length;
+	listInit(b);
+}
+
+// Node at 1-based position pos, walking from the nearer end
+struct Node *nodeAt(struct List *l, int pos) {
+	struct Node *temp = l->head;
+	int i;
+	if (pos <= l->length / 2)
+		for (i = 1; i < pos; i++)
+			temp = temp->next;
+	else
+		for (i = l->length; i >= pos; i--)
+			temp = temp->prev;
+	return temp;
+}
+
+// Move all of b into a right after node at (NULL = at the front), O(1)
+void listSpliceAfter(struct List *a, struct Node *at, struct List *b) {
+	if (b->head == NULL)
+		return;
+	if (a->head == NULL || (at != NULL && at == a->head->prev)) {
+		listConcat(a, b);
+		return;
+	}
+	linkBefore(at ? at->next : a->head, b->head, b->head->prev);
+	if (at == NULL)
+		a->head = b->head;
+	a->length += b->length;
+	listInit(b);
+}
+
+// Split a before node first (not the head): first and everything after it
+// move to the end of b. Relinking is O(1), but the cached lengths need the
+// size of one part, so it counts from first towards both ends at once and
+// stops at whichever end it reaches first: O(min(front, tail)).
+void listSplitAt(struct List *a, struct Node *first, struct List *b) {
+	struct Node *last = a->head->prev, *fwd = first, *back = first;
+	struct List tailPart;
+	int steps = 0, tailLen;
+	for (;;) {
+		if (fwd == last) {	// tail part is steps + 1 nodes
+			tailLen = steps + 1;
+			break;
+		}
+		if (back == a->head) {	// front part is steps nodes
+			tailLen = a->length - steps;
+			break;
+		}
+		fwd = fwd->next;
+		back = back->prev;
+		steps++;
+	}
+	// close the front part
+	first->prev->next = a->head;
+	a->head->prev = first->prev;
+	// close the tail part
+	first->prev = last;
+	last->next = first;
+	tailPart.head = first;
+	tailPart.length = tailLen;
+	a->length -= tailLen;
+	listConcat(b, &tailPart);
+}
+
+// Menu wrappers: positions are turned into nodes with nodeAt(), which
+// walks O(min(pos, length - pos)); the list operations themselves work
+// on nodes.
+void listSplice(struct List *a, int pos, struct List *b) {
+	if (pos < 0 || pos > a->length) {
+		printf("\nCan't splice, position out of range");
+		return;
+	}
+	listSpliceAfter(a, pos == 0 ? NULL : nodeAt(a, pos), b);
+}
+
+void listSplit(struct List *a, int pos, struct List *b) {
+	if (pos < 1 || pos >= a->length) {
+		printf("\nCan't split, position out of range");
+		return;
+	}
+	listSplitAt(a, nodeAt(a, pos + 1), b);
+}
+
+// Search for a value
+void search(struct List *l, int item) {
+	struct Node *temp = l->head;
+	int i = 1;
+	if (!temp) {
+		printf("\nEmpty List");
+		return;
+	}
+	do {
+		if (temp->data == item) {
+			printf("\nItem %d found at position %d", item, i);
+			return;
+		}
+		temp = temp->next;
+		i++;
+	} while (temp != l->head);
+	printf("\nItem %d not found", item);
+}
+
+// Display the list
+void display(struct List *l, int id) {
+	struct Node *temp = l->head;
+	printf("\nList %d (length %d): ", id, l->length);
+	if (!temp) {
+		printf("empty");
+		return;
+	}
+	do {
+		printf("%d ", temp->data);
+		temp = temp->next;
+	} while (temp != l->head);
+}
+
+// Compare per-element insertEnd as in DLL.C (malloc plus a position walk)
+// against a single bulk build
+void benchmark(int n) {
+	struct Node *head = NULL, *temp, *nn, *last;
+	struct List l;
+	int *arr = (int *)malloc(n * sizeof(int));
+	int i, pos;
+	clock_t t;
+	for (i = 0; i < n; i++)
+		arr[i] = i;
+
+	t = clock();
+	for (i = 0; i < n; i++) {
+		nn = (struct Node *)malloc(sizeof(struct Node));
+		nn->data = arr[i];
+		if (head == NULL) {
+			nn->next = nn->prev = nn;
+			head = nn;
+			continue;
+		}
+		last = head->prev;
+		nn->next = head;
+		nn->prev = last;
+		last->next = nn;
+		head->prev = nn;
+		for (pos = 1, temp = head; temp->next != head; temp = temp->next)
+			pos++;
+	}
+	printf("\nPer-element insertEnd: %.3f s", (double)(clock() - t) / CLOCKS_PER_SEC);
+
+	t = clock();
+	listInit(&l);
+	listBuild(&l, arr, n);
+	printf("\nBulk build:            %.3f s (length %d)", (double)(clock() - t) / CLOCKS_PER_SEC, l.length);
+
+	head->prev->next = NULL;
+	while (head) {
+		temp = head;
+		head = head->next;
+		free(temp);
+	}
+	free(arr);
+}
+
+int readList() {
+	int id;
+	scanf("%d", &id);
+	if (id < 0 || id >= LISTS) {
+		printf("\nInvalid list, using list 0");
+		id = 0;
+	}
+	return id;
+}
+
+// Main menu
+void main() {
+	struct List lists[LISTS];
+	int choice, val, pos, a, b, n, i;
+	int *arr;
+	for (i = 0; i < LISTS; i++)
+		listInit(&lists[i]);
+	clrscr();
+	do {
+		printf("\n===== Circular Doubly Linked Lists (0-%d) =====\n", LISTS - 1);
+		printf("1. Insert Front\n2. Insert End\n3. Delete Front\n4. Delete End\n5. Build From Array\n6. Concatenate\n7. Splice After Position\n8. Split After Position\n9. Search\n10. Display All\n11. Benchmark\n12. Exit\n");
+		printf("Enter your choice: ");
+		scanf("%d", &choice);
+		switch (choice) {
+		case 1:
+			printf("Enter list and value: ");
+			a = readList();
+			scanf("%d", &val);
+			insertFront(&lists[a], val);
+			break;
+		case 2:
+			printf("Enter list and value: ");
+			a = readList();
+			scanf("%d", &val);
+			insertEnd(&lists[a], val);
+			break;
+		case 3:
+			printf("Enter list: ");
+			deleteFront(&lists[readList()]);
+			break;
+		case 4:
+			printf("Enter list: ");
+			deleteEnd(&lists[readList()]);
+			break;
+		case 5:
+			printf("Enter list, count and values: ");
+			a = readList();
+			scanf("%d", &n);
+			if (n <= 0)
+				break;
+			arr = (int *)malloc(n * sizeof(int));
+			for (i = 0; i < n; i++)
+				scanf("%d", &arr[i]);
+			listBuild(&lists[a], arr, n);
+			free(arr);
+			break;
+		case 6:
+			printf("Enter destination and source list: ");
+			a = readList();
+			b = readList();
+			if (a != b)
+				listConcat(&lists[a], &lists[b]);
+			break;
+		case 7:
+			printf("Enter destination list, position and source list: ");
+			a = readList();
+			scanf("%d", &pos);
+			b = readList();
+			if (a != b)
+				listSplice(&lists[a], pos, &lists[b]);
+			break;
+		case 8:
+			printf("Enter list, position and destination list: ");
+			a = readList();
+			scanf("%d", &pos);
+			b = readList();
+			if (a != b)
+				listSplit(&lists[a], pos, &lists[b]);
+			break;
+		case 9:
+			printf("Enter list and value to search: ");
+			a = readList();
+			scanf("%d", &val);
+			search(&lists[a], val);
+			break;
+		case 10:
+			for (i = 0; i < LISTS; i++)
+				display(&lists[i], i);
+			printf("\n");
+			break;
+		case 11:
+			printf("Enter number of elements: ");
+			scanf("%d", &n);
+			if (n > 0)
+				benchmark(n);
+			break;
+		case 12:
+			printf("Exiting...\n");
+			break;
+		default:
+			printf("Invalid choice\n");
+		}
+	} while (choice != 12);
+	freePool();
+	getch();
+}
@@ -0,0 +1,615 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "bytecode.h"
+
+// Cache of compiled infix expressions.
+//
+// Instead of running infixToPostfix() and evaluatePostfix() on the text
+// every time, an expression is compiled once into an optimized postfix
+// program and kept in an LRU cache keyed by the expression text with
+// whitespace normalized. Compilation runs the shunting-yard algorithm, but
+// instead of printing postfix it builds an expression DAG:
+//
+//   - nodes are hash-consed, so equal subexpressions become one node
+//     (common-subexpression elimination); + and * operands are put in a
+//     canonical order so a+b and b+a are shared too
+//   - operations on constants are folded, including constants split
+//     across a chain like (x + 2) - 5, unless the result is too wide for
+//     a bytecode literal; then the operation is done at run time
+//   - algebraic identities are applied: x+0, x*1, x*0, x-x, x^0, x^1,
+//     1^x, --x, x-(-y). A rule that drops a subexpression is skipped if
+//     that subexpression could fail (divide by zero) at run time.
+//
+// The DAG is then written out as postfix bytecode (bytecode.h). A node
+// used more than once is computed once, kept with OP_STORE in a temporary
+// and read back with OP_LOAD.
+//
+// Values are 64-bit integers; +, -, * and ^ wrap around on overflow.
+
+enum { LPAREN = OP_COUNT };
+
+#define MAX_VARS 26
+#define NAME_LEN 32
+#define I64_MIN ((long long)(1ULL << 63))
+
+typedef unsigned long long u64;
+
+struct Program {
+    long long *code;
+    int len, maxDepth, nTemps;
+    char names[MAX_VARS][NAME_LEN];
+    int nVars;
+};
+
+// ---------- Expression DAG ----------
+
+struct Node {
+    int op;
+    long long val;     // literal, or variable index
+    int l, r;          // children, -1 if none
+    int canFail;       // subtree contains a division that may fail
+    int uses, temp, done;
+};
+
+struct Dag {
+    struct Node *nodes;
+    int n, cap;
+    int *hash, hashCap;    // node index + 1, 0 = empty
+    char names[MAX_VARS][NAME_LEN];
+    int nVars;
+};
+
+unsigned hashNode(int op, long long val, int l, int r) {
+    u64 h = (u64)op * 0x9E3779B97F4A7C15ULL ^ (u64)val;
+    h = (h ^ (unsigned)l) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (unsigned)r) * 0x94D049BB133111EBULL;
+    return (unsigned)(h >> 32);
+}
+
+void *grow(void *p, size_t size) {
+    p = realloc(p, size);
+    if (p == NULL) { printf("Out of memory\n"); exit(1); }
+    return p;
+}
+
+// Find or add the node (op, val, l, r)
+int node(struct Dag *d, int op, long long val, int l, int r) {
+    struct Node *x;
+    unsigned i, mask;
+    int k;
+    if (d->n * 2 >= d->hashCap) {   // rebuild at half load
+        d->hashCap = d->hashCap ? d->hashCap * 2 : 64;
+        d->hash = (int*)grow(d->hash, d->hashCap * sizeof(int));
+        memset(d->hash, 0, d->hashCap * sizeof(int));
+        for (k = 0; k < d->n; k++) {
+            x = &d->nodes[k];
+            for (i = hashNode(x->op, x->val, x->l, x->r) & (d->hashCap - 1); d->hash[i]; i = (i + 1) & (d->hashCap - 1));
+            d->hash[i] = k + 1;
+        }
+    }
+    mask = d->hashCap - 1;
+    for (i = hashNode(op, val, l, r) & mask; d->hash[i]; i = (i + 1) & mask) {
+        x = &d->nodes[d->hash[i] - 1];
+        if (x->op == op && x->val == val && x->l == l && x->r == r) return d->hash[i] - 1;
+    }
+    if (d->n == d->cap) {
+        d->cap = d->cap ? d->cap * 2 : 64;
+        d->nodes = (struct Node*)grow(d->nodes, d->cap * sizeof(struct Node));
+    }
+    x = &d->nodes[d->n];
+    x->op = op; x->val = val; x->l = l; x->r = r;
+    x->canFail = (l >= 0 && d->nodes[l].canFail) || (r >= 0 && d->nodes[r].canFail) ||
+                 (op == OP_DIV && !(d->nodes[r].op == OP_NUM && d->nodes[r].val != 0 && d->nodes[r].val != -1));
+    x->uses = x->done = 0;
+    x->temp = -1;
+    d->hash[i] = d->n + 1;
+    return d->n++;
+}
+
+int isNum(struct Dag *d, int x, long long v) { return d->nodes[x].op == OP_NUM && d->nodes[x].val == v; }
+
+long long ipow(long long base, long long e) {
+    u64 r = 1, b = (u64)base;
+    if (e < 0) return base == 1 ? 1 : base == -1 ? (e & 1 ? -1 : 1) : 0;   // integer 1/base^-e
+    for (; e; e >>= 1, b *= b) if (e & 1) r *= b;
+    return (long long)r;
+}
+
+// Apply op to constants; returns 0 if it would fail at run time
+int fold(int op, long long a, long long b, long long *out) {
+    switch (op) {
+        case OP_ADD: *out = (long long)((u64)a + (u64)b); return 1;
+        case OP_SUB: *out = (long long)((u64)a - (u64)b); return 1;
+        case OP_MUL: *out = (long long)((u64)a * (u64)b); return 1;
+        case OP_POW: *out = ipow(a, b); return 1;
+        case OP_DIV:
+            if (b == 0 || (a == I64_MIN && b == -1)) return 0;
+            *out = a / b;
+            return 1;
+    }
+    return 0;
+}
+
+int mkNum(struct Dag *d, long long v) { return node(d, OP_NUM, v, -1, -1); }
+
+int mkNeg(struct Dag *d, int x) {
+    struct Node *n = &d->nodes[x];
+    if (n->op == OP_NUM && n->val != CODE_ARG_MIN) return mkNum(d, -n->val);
+    if (n->op == OP_NEG) return n->l;
+    return node(d, OP_NEG, 0, x, -1);
+}
+
+int mkBin(struct Dag *d, int op, int l, int r) {
+    struct Node *a = &d->nodes[l], *b = &d->nodes[r];
+    long long v;
+    int t;
+    if (a->op == OP_NUM && b->op == OP_NUM && fold(op, a->val, b->val, &v) && CODE_FITS(v)) return mkNum(d, v);
+    switch (op) {
+        case OP_SUB:
+            if (l == r && !a->canFail) return mkNum(d, 0);
+            if (b->op == OP_NUM && b->val != CODE_ARG_MIN) return mkBin(d, OP_ADD, l, mkNum(d, -b->val));
+            if (b->op == OP_NEG) return mkBin(d, OP_ADD, l, b->l);
+            if (isNum(d, l, 0)) return mkNeg(d, r);
+            break;
+        case OP_ADD:
+            if (b->op == OP_NEG) return mkBin(d, OP_SUB, l, b->l);
+            if (a->op == OP_NEG) return mkBin(d, OP_SUB, r, a->l);
+            break;
+        case OP_DIV:
+            if (isNum(d, r, 1)) return l;   // not x / -1 -> -x: INT64_MIN / -1 must still fail
+            break;
+        case OP_POW:
+            if (isNum(d, r, 0) && !a->canFail) return mkNum(d, 1);
+            if (isNum(d, r, 1)) return l;
+            if (isNum(d, l, 1) && !b->canFail) return mkNum(d, 1);
+            break;
+    }
+    if (op == OP_ADD || op == OP_MUL) {
+        // Canonical order: constant on the right, otherwise lower node first
+        if (a->op == OP_NUM || (b->op != OP_NUM && l > r)) { t = l; l = r; r = t; a = &d->nodes[l]; b = &d->nodes[r]; }
+        if (b->op == OP_NUM) {
+            if (op == OP_ADD && b->val == 0) return l;
+            if (op == OP_MUL && b->val == 1) return l;
+            if (op == OP_MUL && b->val == -1) return mkNeg(d, l);
+            if (op == OP_MUL && b->val == 0 && !a->canFail) return r;
+            // (x op c1) op c2  ->  x op (c1 op c2)
+            if (a->op == op && d->nodes[a->r].op == OP_NUM && fold(op, d->nodes[a->r].val, b->val, &v) && CODE_FITS(v)) {
+                t = a->l;   // read before mkNum can move the node array
+                return mkBin(d, op, t, mkNum(d, v));
+            }
+        }
+    }
+    return node(d, op, 0, l, r);
+}
+
+int varIndex(struct Dag *d, const char *name, int len) {
+    int i;
+    if (len >= NAME_LEN) return -1;
+    for (i = 0; i < d->nVars; i++) if (strncmp(d->names[i], name, len) == 0 && d->names[i][len] == '\0') return i;
+    if (d->nVars == MAX_VARS) return -1;
+    memcpy(d->names[d->nVars], name, len);
+    d->names[d->nVars][len] = '\0';
+    return d->nVars++;
+}
+
+// ---------- Shunting-yard into the DAG ----------
+
+int precedence(int op) {
+    switch (op) {
+        case OP_POW: return 4;
+        case OP_NEG: return 3;
+        case OP_MUL:
+        case OP_DIV: return 2;
+        case OP_ADD:
+        case OP_SUB: return 1;
+        default: return 0;
+    }
+}
+
+// Pop one operator and combine its operands on the node stack
+int reduce(struct Dag *d, int *ops, int *opTop, int *vals, int *valTop) {
+    int op = ops[(*opTop)--];
+    if (op == OP_NEG) {
+        if (*valTop < 0) return 0;
+        vals[*valTop] = mkNeg(d, vals[*valTop]);
+        return 1;
+    }
+    if (*valTop < 1) return 0;
+    (*valTop)--;
+    vals[*valTop] = mkBin(d, op, vals[*valTop], vals[*valTop + 1]);
+    return 1;
+}
+
+// Parse text into d; returns the root node, or -1 with *err set
+int parse(struct Dag *d, const char *s, const char **err) {
+    int len = strlen(s), *ops = (int*)malloc((len + 1) * sizeof(int)), *vals = (int*)malloc((len + 1) * sizeof(int));
+    int opTop = -1, valTop = -1, expectOperand = 1, op, i = 0, j, root = -1;
+    long long num;
+    *err = NULL;
+    while (s[i] && *err == NULL) {
+        if (isspace((unsigned char)s[i])) { i++; continue; }
+        if (isalnum((unsigned char)s[i]) || s[i] == '_') {
+            if (!expectOperand) { *err = "missing operator"; break; }
+            if (isdigit((unsigned char)s[i])) {
+                for (num = 0; isdigit((unsigned char)s[i]) && num >= 0; i++)
+                    num = num > (CODE_ARG_MAX - (s[i] - '0')) / 10 ? -1 : num * 10 + (s[i] - '0');
+                if (num < 0) { *err = "number too large"; break; }
+                if (isalpha((unsigned char)s[i]) || s[i] == '_') { *err = "letter inside number"; break; }
+                vals[++valTop] = mkNum(d, num);
+            }
+            else {
+                for (j = i; isalnum((unsigned char)s[i]) || s[i] == '_'; i++);
+                if ((op = varIndex(d, s + j, i - j)) < 0) { *err = "too many or too long variable names"; break; }
+                vals[++valTop] = node(d, OP_VAR, op, -1, -1);
+            }
+            expectOperand = 0;
+            continue;
+        }
+        switch (s[i++]) {
+            case '(':
+                if (!expectOperand) *err = "missing operator";
+                else ops[++opTop] = LPAREN;
+                continue;
+            case ')':
+                if (expectOperand) { *err = "missing operand"; continue; }
+                while (opTop >= 0 && ops[opTop] != LPAREN) reduce(d, ops, &opTop, vals, &valTop);
+                if (opTop < 0) *err = "unmatched ')'";
+                else opTop--;
+                continue;
+            case '+': op = OP_ADD; break;
+            case '-': op = OP_SUB; break;
+            case '*': op = OP_MUL; break;
+            case '/': op = OP_DIV; break;
+            case '^': op = OP_POW; break;
+            default: *err = "unexpected character"; continue;
+        }
+        if (expectOperand) {   // unary
+            if (op == OP_SUB) ops[++opTop] = OP_NEG;
+            else if (op != OP_ADD) *err = "missing operand";
+            continue;
+        }
+        while (opTop >= 0 && ops[opTop] != LPAREN &&
+               (precedence(ops[opTop]) > precedence(op) || (precedence(ops[opTop]) == precedence(op) && op != OP_POW)))
+            reduce(d, ops, &opTop, vals, &valTop);
+        ops[++opTop] = op;
+        expectOperand = 1;
+    }
+    if (*err == NULL && expectOperand) *err = "missing operand";
+    while (*err == NULL && opTop >= 0) {
+        if (ops[opTop] == LPAREN) *err = "unmatched '('";
+        else reduce(d, ops, &opTop, vals, &valTop);
+    }
+    if (*err == NULL) root = vals[valTop];
+    free(ops);
+    free(vals);
+    return root;
+}
+
+// ---------- DAG to bytecode ----------
+
+void countUses(struct Dag *d, int x) {
+    struct Node *n = &d->nodes[x];
+    if (n->uses++ > 0) return;
+    if (n->l >= 0) countUses(d, n->l);
+    if (n->r >= 0) countUses(d, n->r);
+}
+
+void emitNode(struct Dag *d, struct Program *p, int x, int *depth) {
+    struct Node *n = &d->nodes[x];
+    if (n->done) {   // shared subexpression already computed
+        p->code[p->len++] = CODE(OP_LOAD, n->temp);
+        (*depth)++;
+    }
+    else if (n->op == OP_NUM || n->op == OP_VAR) {
+        p->code[p->len++] = CODE(n->op, n->val);
+        (*depth)++;
+    }
+    else {
+        emitNode(d, p, n->l, depth);
+        if (n->r >= 0) { emitNode(d, p, n->r, depth); (*depth)--; }
+        p->code[p->len++] = CODE(n->op, 0);
+        if (n->uses > 1) {
+            n->temp = p->nTemps++;
+            n->done = 1;
+            p->code[p->len++] = CODE(OP_STORE, n->temp);
+        }
+    }
+    if (*depth > p->maxDepth) p->maxDepth = *depth;
+}
+
+// Compile text into p; returns 0 and sets *err on a syntax error
+int compile(const char *text, struct Program *p, const char **err) {
+    struct Dag d;
+    int root, depth = 0, i;
+    memset(&d, 0, sizeof(d));
+    memset(p, 0, sizeof(*p));
+    root = parse(&d, text, err);
+    if (root >= 0) {
+        countUses(&d, root);
+        // op + store per node, plus a load per extra use (at most 2 per node)
+        p->code = (long long*)malloc(4 * d.n * sizeof(long long));
+        emitNode(&d, p, root, &depth);
+        p->nVars = d.nVars;
+        for (i = 0; i < d.nVars; i++) strcpy(p->names[i], d.names[i]);
+    }
+    free(d.nodes);
+    free(d.hash);
+    return root >= 0;
+}
+
+// Run p with vars[k] bound to variable k; returns 0 on division by zero
+int evaluate(struct Program *p, const long long *vars, long long *result) {
+    long long stackBuf[64], tempBuf[16], *stack = stackBuf, *temps = tempBuf, x, y;
+    int k, sp = 0, ok = 1;
+    if (p->maxDepth > 64) stack = (long long*)malloc(p->maxDepth * sizeof(long long));
+    if (p->nTemps > 16) temps = (long long*)malloc(p->nTemps * sizeof(long long));
+    for (k = 0; k < p->len && ok; k++) {
+        long long w = p->code[k];
+        switch (CODE_OP(w)) {
+            case OP_NUM: stack[sp++] = CODE_ARG(w); break;
+            case OP_VAR: stack[sp++] = vars[CODE_ARG(w)]; break;
+            case OP_LOAD: stack[sp++] = temps[CODE_ARG(w)]; break;
+            case OP_STORE: temps[CODE_ARG(w)] = stack[sp - 1]; break;
+            case OP_NEG: stack[sp - 1] = (long long)(0 - (u64)stack[sp - 1]); break;
+            default:
+                y = stack[--sp];
+                x = stack[sp - 1];
+                ok = fold(CODE_OP(w), x, y, &stack[sp - 1]);
+        }
+    }
+    *result = stack[0];
+    if (stack != stackBuf) free(stack);
+    if (temps != tempBuf) free(temps);
+    return ok;
+}
+
+void printProgram(struct Program *p) {
+    static const char sym[] = "??+-*/^~";
+    int k;
+    printf("Optimized postfix: ");
+    for (k = 0; k < p->len; k++) {
+        long long w = p->code[k];
+        switch (CODE_OP(w)) {
+            case OP_NUM: printf("%lld ", CODE_ARG(w)); break;
+            case OP_VAR: printf("%s ", p->names[CODE_ARG(w)]); break;
+            case OP_STORE: printf("st%lld ", CODE_ARG(w)); break;
+            case OP_LOAD: printf("ld%lld ", CODE_ARG(w)); break;
+            default: printf("%c ", sym[CODE_OP(w)]);
+        }
+    }
+    printf("\n");
+}
+
+// ---------- LRU cache ----------
+
+struct Entry {
+    char *key;
+    struct Program prog;
+    struct Entry *hashNext;
+    struct Entry *prev, *next;   // LRU list, most recent first
+};
+
+struct Cache {
+    struct Entry **buckets;
+    int nBuckets, count, capacity;
+    struct Entry *head, *tail;
+    long hits, misses, evictions;
+};
+
+unsigned hashText(const char *s) {
+    unsigned h = 2166136261u;
+    while (*s) h = (h ^ (unsigned char)*s++) * 16777619u;
+    return h;
+}
+
+int isWordChar(char ch) { return isalnum((unsigned char)ch) || ch == '_'; }
+
+// Cache key: the text with whitespace dropped, except that one space is
+// kept between two names or numbers ("a b" must not become "ab")
+char *normalize(const char *text) {
+    char *key = (char*)malloc(strlen(text) + 1), *k = key;
+    if (key == NULL) return NULL;
+    for (; *text; text++) {
+        if (!isspace((unsigned char)*text)) *k++ = *text;
+        else if (k > key && isWordChar(k[-1])) {
+            while (isspace((unsigned char)text[1])) text++;
+            if (isWordChar(text[1])) *k++ = ' ';
+        }
+    }
+    *k = '\0';
+    return key;
+}
+
+void unlinkEntry(struct Cache *c, struct Entry *e) {
+    if (e->prev) e->prev->next = e->next; else c->head = e->next;
+    if (e->next) e->next->prev = e->prev; else c->tail = e->prev;
+}
+
+void pushFront(struct Cache *c, struct Entry *e) {
+    e->prev = NULL;
+    e->next = c->head;
+    if (c->head) c->head->prev = e; else c->tail = e;
+    c->head = e;
+}
+
+void evictOne(struct Cache *c) {
+    struct Entry *e = c->tail, **pp;
+    unlinkEntry(c, e);
+    for (pp = &c->buckets[hashText(e->key) % c->nBuckets]; *pp != e; pp = &(*pp)->hashNext);
+    *pp = e->hashNext;
+    free(e->key);
+    free(e->prog.code);
+    free(e);
+    c->count--;
+    c->evictions++;
+}
+
+void cacheInit(struct Cache *c, int capacity) {
+    memset(c, 0, sizeof(*c));
+    c->capacity = capacity;
+    c->nBuckets = 1024;
+    c->buckets = (struct Entry**)calloc(c->nBuckets, sizeof(struct Entry*));
+}
+
+void setCapacity(struct Cache *c, int capacity) {
+    c->capacity = capacity < 0 ? 0 : capacity;
+    while (c->count > c->capacity) evictOne(c);
+}
+
+void cacheFree(struct Cache *c) {
+    setCapacity(c, 0);
+    free(c->buckets);
+}
+
+// Compiled program for text, from the cache or freshly compiled. With
+// capacity 0 the caller gets a private copy in *scratch to free.
+struct Program *lookup(struct Cache *c, const char *text, struct Program *scratch, const char **err) {
+    char *key = normalize(text);
+    unsigned b;
+    struct Entry *e;
+    if (key == NULL) { *err = "out of memory"; return NULL; }
+    b = hashText(key) % c->nBuckets;
+    for (e = c->buckets[b]; e; e = e->hashNext) {
+        if (strcmp(e->key, key) == 0) {
+            c->hits++;
+            unlinkEntry(c, e);
+            pushFront(c, e);
+            free(key);
+            return &e->prog;
+        }
+    }
+    c->misses++;
+    if (c->capacity == 0) {
+        int ok = compile(key, scratch, err);
+        free(key);
+        return ok ? scratch : NULL;
+    }
+    e = (struct Entry*)malloc(sizeof(struct Entry));
+    if (!compile(key, &e->prog, err)) { free(e); free(key); return NULL; }
+    if (c->count == c->capacity) evictOne(c);
+    e->key = key;
+    e->hashNext = c->buckets[b];
+    c->buckets[b] = e;
+    pushFront(c, e);
+    c->count++;
+    return &e->prog;
+}
+
+// ---------- Demo ----------
+
+struct Binding {
+    char name[NAME_LEN];
+    long long value;
+};
+
+struct Binding env[MAX_VARS];
+int nEnv;
+
+// Bind the program's variables from env; returns 0 if one is unset
+int bind(struct Program *p, long long *vars) {
+    int i, j;
+    for (i = 0; i < p->nVars; i++) {
+        for (j = 0; j < nEnv && strcmp(env[j].name, p->names[i]) != 0; j++);
+        if (j == nEnv) { printf("Variable %s is not set\n", p->names[i]); return 0; }
+        vars[i] = env[j].value;
+    }
+    return 1;
+}
+
+void benchmark(struct Cache *c, long n) {
+    static const char *formulas[] = {
+        "(a + b) * (a + b) - (b + a) / 2",
+        "x * 1 + 0 * (y - 3) + (x + 2) - 5",
+        "(p - q) ^ 2 + (p - q) ^ 3 + -(-(p - q))",
+        "rate * 12 + rate * 12 / (months + 1)",
+        "((a*b + c) * (a*b + c)) ^ 2 - (c + b*a)",
+        "2 ^ 3 ^ 2 + 4 * (7 - 3) - x",
+        "(x + y) * (x - y) + (y + x) * (y - x)",
+        "- - a + b - (a + b) * 0 + c / 1"
+    };
+    int nf = sizeof(formulas) / sizeof(formulas[0]), pass;
+    long long vars[MAX_VARS], r, sum[2] = { 0, 0 };
+    struct Program scratch, *p;
+    const char *err;
+    long i, hits = c->hits, misses = c->misses;
+    int savedCap = c->capacity, k;
+    clock_t t;
+    for (k = 0; k < MAX_VARS; k++) vars[k] = k + 3;
+    for (pass = 0; pass < 2; pass++) {   // pass 0: no caching, pass 1: cache
+        if (pass == 0) setCapacity(c, 0);
+        else setCapacity(c, savedCap > 0 ? savedCap : 16);
+        t = clock();
+        for (i = 0; i < n; i++) {
+            p = lookup(c, formulas[i % nf], &scratch, &err);
+            if (p && evaluate(p, vars, &r)) sum[pass] += r;
+            if (p == &scratch) free(scratch.code);
+        }
+        printf("%s: %ld evaluations in %.3f s\n", pass ? "With cache" : "Re-parsing every time", n,
+               (double)(clock() - t) / CLOCKS_PER_SEC);
+    }
+    printf("Results %s; benchmark hits %ld, misses %ld\n", sum[0] == sum[1] ? "match" : "DIFFER",
+           c->hits - hits, c->misses - misses);
+    setCapacity(c, savedCap);
+}
+
+void main() {
+    struct Cache cache;
+    struct Program scratch, *p;
+    long long vars[MAX_VARS], result, value;
+    char line[1024], name[NAME_LEN];
+    const char *err;
+    int choice, cap, j;
+    long n;
+    clrscr();
+    cacheInit(&cache, 64);
+    do {
+        printf("\n1.Evaluate Expression 2.Set Variable 3.Set Cache Capacity 4.Cache Stats 5.Benchmark (clears cache) 6.Exit\nEnter choice: ");
+        if (scanf("%d", &choice) != 1) break;
+        getchar();
+        switch (choice) {
+            case 1:
+                printf("Enter an Infix Expression: ");
+                if (fgets(line, sizeof(line), stdin) == NULL) break;
+                line[strcspn(line, "\n")] = '\0';
+                p = lookup(&cache, line, &scratch, &err);
+                if (p == NULL) { printf("Error: %s\n", err); break; }
+                printProgram(p);
+                if (bind(p, vars)) {
+                    if (evaluate(p, vars, &result)) printf("Result: %lld\n", result);
+                    else printf("Division by zero (or INT64_MIN / -1)\n");
+                }
+                if (p == &scratch) free(scratch.code);
+                break;
+            case 2:
+                printf("Enter variable name and value: ");
+                if (scanf("%31s %lld", name, &value) != 2) break;
+                for (j = 0; j < nEnv && strcmp(env[j].name, name) != 0; j++);
+                if (j == MAX_VARS) { printf("Too many variables\n"); break; }
+                if (j == nEnv) strcpy(env[nEnv++].name, name);
+                env[j].value = value;
+                break;
+            case 3:
+                printf("Enter capacity (0 disables caching): ");
+                scanf("%d", &cap);
+                setCapacity(&cache, cap);
+                break;
+            case 4:
+                printf("Entries %d/%d, hits %ld, misses %ld, evictions %ld\n", cache.count, cache.capacity,
+                       cache.hits, cache.misses, cache.evictions);
+                break;
+            case 5:
+                printf("Enter number of evaluations: ");
+                scanf("%ld", &n);
+                if (n > 0) benchmark(&cache, n);
+                break;
+            case 6: break;
+            default: printf("Invalid choice");
+        }
+    } while (choice != 6);
+    cacheFree(&cache);
+    getch();
+}
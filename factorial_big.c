@@ -0,0 +1,601 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+// Exact factorials of large n, and helpers that avoid building them.
+//
+// factorial.c multiplies 1*2*...*n in an int. Here n! is computed with
+// Luschny's prime swing:
+//
+//   n! = (n/2)!^2 * swing(n),  swing(n) = prod p^e over primes p <= n,
+//   e = sum over i of (floor(n / p^i) mod 2)
+//
+// The prime powers are packed into words and multiplied in a balanced
+// product tree, so both operands of every multiplication have similar
+// size. Multiplication is schoolbook for small operands, Karatsuba for
+// medium ones and a number-theoretic transform (NTT) for very large ones,
+// where even Karatsuba is too slow. The two halves of a product tree,
+// and (n/2)! and swing(n), are computed on separate threads.
+//
+// Binomials and multinomials are built from prime exponents (Legendre's
+// formula) without computing any factorial. n! mod m loops over n with
+// a shortcut through Wilson's theorem for primes.
+
+#define BASE 1000000000u
+#define KARATSUBA 32      // limbs; schoolbook below this
+#define NTT_MIN 1500      // limbs in the smaller operand; NTT from here on
+#define LEAF 16           // factors multiplied sequentially in a tree leaf
+#define MAX_N 100000000L  // largest n for exact results: primes stay far below
+                          // BASE and the sieve takes at most ~300 MB
+
+typedef unsigned __int128 u128;
+
+int maxDepth = 2;         // product trees fork threads down to this depth
+
+// ---------- Big integers, base 10^9 ----------
+
+struct Big {
+    uint32_t *d;          // limbs, least significant first
+    int n, cap;           // n >= 1; zero is a single 0 limb
+};
+
+// Every buffer below goes through these; there is no way to carry on
+// half way through a product, so running out of memory ends the program
+uint32_t *newLimbs(int n, int zero){
+    uint32_t *p = (uint32_t*)(zero ? calloc(n, sizeof(uint32_t)) : malloc(n * sizeof(uint32_t)));
+    if(p == NULL){ printf("Out of memory\n"); exit(1); }
+    return p;
+}
+
+uint64_t *newWords(int n){
+    uint64_t *p = (uint64_t*)malloc(n * sizeof(uint64_t));
+    if(p == NULL){ printf("Out of memory\n"); exit(1); }
+    return p;
+}
+
+void bigInit(struct Big *x, uint32_t v){
+    x->cap = 4;
+    x->d = newLimbs(x->cap, 0);
+    x->d[0] = v;
+    x->n = 1;
+}
+
+void bigFree(struct Big *x){ free(x->d); }
+
+void trim(struct Big *x){ while(x->n > 1 && x->d[x->n-1] == 0) x->n--; }
+
+// x *= v for v < BASE
+void bigMulSmall(struct Big *x, uint32_t v){
+    uint64_t carry = 0, cur;
+    int i;
+    for(i = 0; i < x->n; i++){
+        cur = (uint64_t)x->d[i] * v + carry;
+        carry = cur / BASE;
+        x->d[i] = (uint32_t)(cur - carry * BASE);
+    }
+    if(carry){
+        if(x->n == x->cap){
+            x->cap *= 2;
+            x->d = (uint32_t*)realloc(x->d, x->cap * sizeof(uint32_t));
+            if(x->d == NULL){ printf("Out of memory\n"); exit(1); }
+        }
+        x->d[x->n++] = (uint32_t)carry;
+    }
+}
+
+void addInto(uint32_t *dst, const uint32_t *src, int sn){   // dst has room for the carry
+    uint32_t carry = 0, s;
+    int i;
+    for(i = 0; i < sn || carry; i++){
+        s = dst[i] + (i < sn ? src[i] : 0) + carry;
+        carry = s >= BASE;
+        dst[i] = carry ? s - BASE : s;
+    }
+}
+
+void subInto(uint32_t *dst, const uint32_t *src, int sn){   // result known to be >= 0
+    int64_t s;
+    uint32_t borrow = 0;
+    int i;
+    for(i = 0; i < sn || borrow; i++){
+        s = (int64_t)dst[i] - (i < sn ? src[i] : 0) - borrow;
+        borrow = s < 0;
+        dst[i] = (uint32_t)(borrow ? s + BASE : s);
+    }
+}
+
+// ---------- NTT over p = 2^64 - 2^32 + 1 ----------
+//
+// Limbs are split into base 1000 digits; a product coefficient is then at
+// most 1000^2 times the shorter length, far below p, so one prime is
+// enough and no CRT is needed.
+
+#define P 0xFFFFFFFF00000001ULL
+#define G 7               // generator of the multiplicative group
+
+uint64_t reduce(u128 x){  // x mod p, using 2^64 = 2^32 - 1 and 2^96 = -1
+    uint64_t lo = (uint64_t)x, hi = (uint64_t)(x >> 64);
+    uint64_t hh = hi >> 32, hl = hi & 0xFFFFFFFFu, t, u, r;
+    t = lo - hh;
+    if(lo < hh) t -= 0xFFFFFFFFu;
+    u = hl * 0xFFFFFFFFu;
+    r = t + u;
+    if(r < u) r += 0xFFFFFFFFu;
+    return r >= P ? r - P : r;
+}
+
+uint64_t mulP(uint64_t a, uint64_t b){ return reduce((u128)a * b); }
+uint64_t addP(uint64_t a, uint64_t b){ uint64_t r = a + b; return (r < a || r >= P) ? r - P : r; }
+uint64_t subP(uint64_t a, uint64_t b){ return a >= b ? a - b : a + (P - b); }
+
+uint64_t powP(uint64_t b, uint64_t e){
+    uint64_t r = 1;
+    for(; e; e >>= 1, b = mulP(b, b)) if(e & 1) r = mulP(r, b);
+    return r;
+}
+
+void ntt(uint64_t *a, int n, int invert){
+    uint64_t *w = newWords(n / 2), root, u, v, inv;
+    int i, j, k, len, bit, step;
+    for(i = 1, j = 0; i < n; i++){   // bit-reversal permutation
+        for(bit = n >> 1; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if(i < j){ u = a[i]; a[i] = a[j]; a[j] = u; }
+    }
+    root = powP(G, (P - 1) / n);
+    if(invert) root = powP(root, P - 2);
+    for(w[0] = 1, i = 1; i < n / 2; i++) w[i] = mulP(w[i-1], root);
+    for(len = 2; len <= n; len <<= 1){
+        step = n / len;
+        for(i = 0; i < n; i += len){
+            for(k = 0; k < len / 2; k++){
+                u = a[i+k];
+                v = mulP(a[i+k+len/2], w[k * step]);
+                a[i+k] = addP(u, v);
+                a[i+k+len/2] = subP(u, v);
+            }
+        }
+    }
+    if(invert){
+        inv = powP(n, P - 2);
+        for(i = 0; i < n; i++) a[i] = mulP(a[i], inv);
+    }
+    free(w);
+}
+
+void toDigits(const uint32_t *a, int na, uint64_t *f, int n){
+    int i;
+    memset(f, 0, n * sizeof(uint64_t));
+    for(i = 0; i < na; i++){
+        f[3*i] = a[i] % 1000;
+        f[3*i+1] = a[i] / 1000 % 1000;
+        f[3*i+2] = a[i] / 1000000;
+    }
+}
+
+void nttMul(const uint32_t *a, int na, const uint32_t *b, int nb, uint32_t *out){
+    int n = 1, i, square = a == b && na == nb;
+    uint64_t *fa, *fb, carry = 0, cur, digit[3];
+    while(n < 3 * (na + nb)) n <<= 1;
+    fa = newWords(n);
+    fb = square ? fa : newWords(n);
+    toDigits(a, na, fa, n);
+    ntt(fa, n, 0);
+    if(!square){ toDigits(b, nb, fb, n); ntt(fb, n, 0); }
+    for(i = 0; i < n; i++) fa[i] = mulP(fa[i], fb[i]);
+    ntt(fa, n, 1);
+    for(i = 0; i < na + nb; i++){   // carry base 1000 digits back into limbs
+        cur = fa[3*i] + carry;     digit[0] = cur % 1000; carry = cur / 1000;
+        cur = fa[3*i+1] + carry;   digit[1] = cur % 1000; carry = cur / 1000;
+        cur = fa[3*i+2] + carry;   digit[2] = cur % 1000; carry = cur / 1000;
+        out[i] = (uint32_t)(digit[0] + 1000 * digit[1] + 1000000 * digit[2]);
+    }
+    free(fa);
+    if(!square) free(fb);
+}
+
+// ---------- Multiplication ----------
+
+// out[0..na+nb) = a * b, out must not overlap a or b
+void mulRaw(const uint32_t *a, int na, const uint32_t *b, int nb, uint32_t *out){
+    const uint32_t *t;
+    uint32_t *s1, *s2, *z1;
+    uint64_t cur, carry;
+    int i, j, m, n1, n2;
+    if(na < nb){ t = a; a = b; b = t; i = na; na = nb; nb = i; }
+    if(nb >= NTT_MIN){ nttMul(a, na, b, nb, out); return; }
+    memset(out, 0, (na + nb) * sizeof(uint32_t));
+    if(nb < KARATSUBA){   // schoolbook
+        for(i = 0; i < nb; i++){
+            carry = 0;
+            for(j = 0; j < na; j++){
+                cur = out[i+j] + (uint64_t)b[i] * a[j] + carry;
+                carry = cur / BASE;
+                out[i+j] = (uint32_t)(cur - carry * BASE);
+            }
+            out[i+na] = (uint32_t)carry;
+        }
+        return;
+    }
+    m = na / 2;
+    if(nb <= m){   // unbalanced: split only a
+        z1 = newLimbs(na - m + nb, 0);
+        mulRaw(a, m, b, nb, out);
+        mulRaw(a + m, na - m, b, nb, z1);
+        addInto(out + m, z1, na - m + nb);
+        free(z1);
+        return;
+    }
+    // Karatsuba: a*b = z2*B^2m + ((a0+a1)(b0+b1) - z0 - z2)*B^m + z0
+    n1 = na - m + 1;
+    n2 = (nb - m > m ? nb - m : m) + 1;
+    s1 = newLimbs(n1, 1);
+    s2 = newLimbs(n2, 1);
+    z1 = newLimbs(n1 + n2, 0);
+    memcpy(s1, a + m, (na - m) * sizeof(uint32_t)); addInto(s1, a, m);
+    memcpy(s2, b, m * sizeof(uint32_t)); addInto(s2, b + m, nb - m);
+    mulRaw(a, m, b, m, out);
+    mulRaw(a + m, na - m, b + m, nb - m, out + 2*m);
+    mulRaw(s1, n1, s2, n2, z1);
+    subInto(z1, out, 2*m);
+    subInto(z1, out + 2*m, na + nb - 2*m);
+    for(i = n1 + n2; i > 0 && z1[i-1] == 0; i--);
+    addInto(out + m, z1, i);
+    free(s1); free(s2); free(z1);
+}
+
+// r = a * b (r may alias a or b)
+void bigMul(struct Big *r, struct Big *a, struct Big *b){
+    uint32_t *out = newLimbs(a->n + b->n, 0);
+    mulRaw(a->d, a->n, b->d, b->n, out);
+    free(r->d);
+    r->d = out;
+    r->n = r->cap = a->n + b->n;
+    trim(r);
+}
+
+// ---------- Product trees ----------
+
+struct TreeJob {
+    uint32_t *f;
+    int lo, hi, depth;
+    struct Big out;
+};
+
+void *treeJob(void *arg);
+
+// out = f[lo] * ... * f[hi-1], all factors < BASE
+void product(uint32_t *f, int lo, int hi, int depth, struct Big *out){
+    struct TreeJob left;
+    struct Big right;
+    pthread_t th;
+    int i, mid, forked;
+    if(hi - lo <= LEAF){
+        bigInit(out, 1);
+        for(i = lo; i < hi; i++) bigMulSmall(out, f[i]);
+        return;
+    }
+    mid = (lo + hi) / 2;
+    left.f = f; left.lo = lo; left.hi = mid; left.depth = depth + 1;
+    forked = depth < maxDepth && hi - lo >= 256 && pthread_create(&th, NULL, treeJob, &left) == 0;
+    if(!forked) treeJob(&left);
+    product(f, mid, hi, depth + 1, &right);
+    if(forked) pthread_join(th, NULL);
+    bigMul(&left.out, &left.out, &right);
+    *out = left.out;
+    bigFree(&right);
+}
+
+void *treeJob(void *arg){
+    struct TreeJob *j = (struct TreeJob*)arg;
+    product(j->f, j->lo, j->hi, j->depth, &j->out);
+    return NULL;
+}
+
+// Collects factors, multiplying small ones together into words < BASE
+// so the tree has fewer leaves
+struct Factors {
+    uint32_t *f;
+    int n, cap;
+};
+
+void addFactor(struct Factors *fs, uint64_t v){
+    uint32_t *f;
+    if(fs->n > 0 && (uint64_t)fs->f[fs->n-1] * v < BASE){ fs->f[fs->n-1] *= (uint32_t)v; return; }
+    if(fs->n == fs->cap){
+        fs->cap = fs->cap ? fs->cap * 2 : 1024;
+        f = (uint32_t*)realloc(fs->f, fs->cap * sizeof(uint32_t));
+        if(f == NULL){ printf("Out of memory\n"); exit(1); }
+        fs->f = f;
+    }
+    fs->f[fs->n++] = (uint32_t)v;
+}
+
+// Adds p^e, split so that every factor stays below BASE
+void addPower(struct Factors *fs, uint64_t p, long e){
+    uint64_t v = 1;
+    for(; e > 0; e--){
+        if(v * p >= BASE){ addFactor(fs, v); v = 1; }
+        v *= p;
+    }
+    if(v > 1) addFactor(fs, v);
+}
+
+void productOf(struct Factors *fs, struct Big *out){
+    if(fs->n == 0) bigInit(out, 1);
+    else product(fs->f, 0, fs->n, 0, out);
+    free(fs->f);
+}
+
+// ---------- Primes ----------
+
+uint32_t *primes;
+int nPrimes;
+long sieveLimit;
+
+// Primes up to n; returns 0 if out of memory
+int sieve(long n){
+    char *comp;
+    long i, j;
+    if(n <= sieveLimit) return 1;
+    comp = (char*)calloc(n + 1, 1);
+    if(comp == NULL) return 0;
+    free(primes);
+    primes = (uint32_t*)malloc((n / 2 + 2) * sizeof(uint32_t));
+    nPrimes = 0;
+    sieveLimit = 0;
+    if(primes == NULL){ free(comp); return 0; }
+    for(i = 2; i <= n; i++){
+        if(comp[i]) continue;
+        primes[nPrimes++] = (uint32_t)i;
+        for(j = i * i; j <= n; j += i) comp[j] = 1;
+    }
+    free(comp);
+    sieveLimit = n;
+    return 1;
+}
+
+long legendre(long n, long p){   // exponent of p in n!
+    long e = 0;
+    while(n){ n /= p; e += n; }
+    return e;
+}
+
+// ---------- Factorial by prime swing ----------
+
+struct Half {
+    long n;
+    struct Big out;
+};
+
+void factorial(long n, struct Big *out);
+
+void swing(long n, struct Big *out){
+    struct Factors fs = { NULL, 0, 0 };
+    long q, e;
+    int i;
+    for(i = 0; i < nPrimes && primes[i] <= n; i++){
+        for(e = 0, q = n / primes[i]; q; q /= primes[i]) e += q & 1;
+        addPower(&fs, primes[i], e);
+    }
+    productOf(&fs, out);
+}
+
+void *halfJob(void *arg){
+    struct Half *h = (struct Half*)arg;
+    factorial(h->n, &h->out);
+    return NULL;
+}
+
+void factorial(long n, struct Big *out){
+    struct Half h;
+    struct Big s;
+    pthread_t th;
+    int forked;
+    if(n < 20){   // fits in a few limbs: multiply directly
+        bigInit(out, 1);
+        for(; n > 1; n--) bigMulSmall(out, (uint32_t)n);
+        return;
+    }
+    h.n = n / 2;   // (n/2)! on another thread while swing(n) runs here
+    forked = maxDepth > 0 && n >= 10000 && pthread_create(&th, NULL, halfJob, &h) == 0;
+    if(!forked) halfJob(&h);
+    swing(n, &s);
+    if(forked) pthread_join(th, NULL);
+    bigMul(&h.out, &h.out, &h.out);
+    bigMul(&h.out, &h.out, &s);
+    *out = h.out;
+    bigFree(&s);
+}
+
+// ---------- Binomial and multinomial ----------
+
+// n! / (k[0]! * ... * k[m-1]!), where the k[i] add up to n <= MAX_N;
+// returns 0 if out of memory
+int multinomial(long n, long *k, int m, struct Big *out){
+    struct Factors fs = { NULL, 0, 0 };
+    long e;
+    int i, j;
+    if(!sieve(n)) return 0;
+    for(i = 0; i < nPrimes && primes[i] <= n; i++){
+        e = legendre(n, primes[i]);
+        for(j = 0; j < m; j++) e -= legendre(k[j], primes[i]);
+        addPower(&fs, primes[i], e);
+    }
+    productOf(&fs, out);
+    return 1;
+}
+
+int binomial(long n, long k, struct Big *out){
+    long ks[2];
+    ks[0] = k; ks[1] = n - k;
+    return multinomial(n, ks, 2, out);
+}
+
+// ---------- Modular ----------
+
+uint64_t mulMod(uint64_t a, uint64_t b, uint64_t m){ return (uint64_t)((u128)a * b % m); }
+
+uint64_t powMod(uint64_t b, uint64_t e, uint64_t m){
+    uint64_t r = 1 % m;
+    for(b %= m; e; e >>= 1, b = mulMod(b, b, m)) if(e & 1) r = mulMod(r, b, m);
+    return r;
+}
+
+int isPrime(uint64_t n){   // deterministic Miller-Rabin for 64-bit n
+    static const uint64_t bases[] = { 2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37 };
+    uint64_t d = n - 1, x;
+    int s = 0, i, r;
+    if(n < 2) return 0;
+    for(i = 0; i < 12; i++) if(n % bases[i] == 0) return n == bases[i];
+    while(!(d & 1)){ d >>= 1; s++; }
+    for(i = 0; i < 12; i++){
+        x = powMod(bases[i], d, n);
+        if(x == 1 || x == n - 1) continue;
+        for(r = 1; r < s && x != n - 1; r++) x = mulMod(x, x, n);
+        if(x != n - 1) return 0;
+    }
+    return 1;
+}
+
+// n! mod m. When m is a prime closer to n than to 0, Wilson's theorem
+// (m-1)! = -1 lets it multiply (n+1)...(m-1) instead.
+uint64_t factorialMod(uint64_t n, uint64_t m){
+    uint64_t r = 1 % m, i;
+    if(n >= m) return 0;
+    if(isPrime(m) && m - 1 - n < n){
+        for(i = n + 1; i < m; i++) r = mulMod(r, i, m);
+        return mulMod(m - 1, powMod(r, m - 2, m), m);   // -1 / ((n+1)...(m-1))
+    }
+    for(i = 2; i <= n; i++) r = mulMod(r, i, m);
+    return r;
+}
+
+// C(n, k) mod prime p, by Lucas' theorem on the base p digits
+uint64_t binomialMod(uint64_t n, uint64_t k, uint64_t p){
+    uint64_t r = 1 % p, a, b;
+    while(n || k){
+        a = n % p; b = k % p;
+        if(b > a) return 0;
+        r = mulMod(r, factorialMod(a, p), p);
+        r = mulMod(r, powMod(mulMod(factorialMod(b, p), factorialMod(a - b, p), p), p - 2, p), p);
+        n /= p; k /= p;
+    }
+    return r;
+}
+
+// ---------- Output ----------
+
+void printBig(struct Big *x){
+    char lead[16];
+    int i, digits = sprintf(lead, "%u", x->d[x->n-1]) + 9 * (x->n - 1), zeros = 0;
+    uint32_t low;
+    printf("%s", lead);
+    if(digits <= 200) for(i = x->n - 2; i >= 0; i--) printf("%09u", x->d[i]);
+    else {
+        for(i = x->n - 2; i >= x->n - 3; i--) printf("%09u", x->d[i]);
+        printf("...");
+        for(i = 2; i >= 0; i--) printf("%09u", x->d[i]);
+    }
+    for(i = 0; i < x->n && x->d[i] == 0; i++) zeros += 9;
+    if(i < x->n) for(low = x->d[i]; low % 10 == 0; low /= 10) zeros++;
+    printf("\n%d digits, %d trailing zeros", digits, zeros);
+}
+
+// Check n! against the plain running product
+void verify(long n){
+    struct Big a, b;
+    long i;
+    int ok = 1;
+    if(!sieve(n)){ printf("Out of memory"); return; }
+    factorial(n, &a);
+    bigInit(&b, 1);
+    for(i = 2; i <= n; i++) bigMulSmall(&b, (uint32_t)i);
+    if(a.n != b.n || memcmp(a.d, b.d, a.n * sizeof(uint32_t)) != 0) ok = 0;
+    printf("%ld! prime swing vs running product: %s", n, ok ? "match" : "MISMATCH");
+    bigFree(&a); bigFree(&b);
+}
+
+void main(){
+    struct Big x;
+    long n, k, *ks;
+    uint64_t m;
+    int choice, i, parts;
+    struct timespec t0, t1;
+    clrscr();
+    do {
+        printf("\n1.Factorial 2.Factorial mod m 3.Binomial 4.Binomial mod p 5.Multinomial 6.Set Threads 7.Verify 8.Exit\nEnter choice: ");
+        if(scanf("%d",&choice) != 1) break;
+        switch(choice){
+            case 1:
+                printf("Enter number: ");
+                scanf("%ld",&n);
+                if(n < 0 || n > MAX_N){ printf("Invalid input"); break; }
+                clock_gettime(CLOCK_MONOTONIC, &t0);
+                if(!sieve(n)){ printf("Out of memory"); break; }
+                factorial(n, &x);
+                clock_gettime(CLOCK_MONOTONIC, &t1);
+                printf("%ld! = ", n); printBig(&x);
+                printf("\nTime: %.3f s", (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9);
+                bigFree(&x);
+                break;
+            case 2:
+                printf("Enter n and m: ");
+                scanf("%ld %llu",&n,(unsigned long long*)&m);
+                if(n < 0 || m == 0){ printf("Invalid input"); break; }
+                printf("%ld! mod %llu = %llu", n, (unsigned long long)m, (unsigned long long)factorialMod(n, m));
+                break;
+            case 3:
+                printf("Enter n and k: ");
+                scanf("%ld %ld",&n,&k);
+                if(k < 0 || n < k || n > MAX_N){ printf("Invalid input"); break; }
+                if(!binomial(n, k, &x)){ printf("Out of memory"); break; }
+                printf("C(%ld,%ld) = ", n, k); printBig(&x);
+                bigFree(&x);
+                break;
+            case 4:
+                printf("Enter n, k and prime p: ");
+                scanf("%ld %ld %llu",&n,&k,(unsigned long long*)&m);
+                if(k < 0 || n < k || !isPrime(m)){ printf("Invalid input"); break; }
+                printf("C(%ld,%ld) mod %llu = %llu", n, k, (unsigned long long)m, (unsigned long long)binomialMod(n, k, m));
+                break;
+            case 5:
+                printf("Enter number of parts: ");
+                scanf("%d",&parts);
+                if(parts < 1){ printf("Invalid input"); break; }
+                ks = (long*)malloc(parts * sizeof(long));
+                if(ks == NULL){ printf("Out of memory"); break; }
+                printf("Enter %d part sizes: ", parts);
+                for(n = 0, i = 0; i < parts; i++){
+                    scanf("%ld",&ks[i]);
+                    if(ks[i] < 0 || ks[i] > MAX_N) n = -1;
+                    if(n >= 0) n += ks[i];
+                }
+                if(n < 0 || n > MAX_N){ printf("Invalid input"); free(ks); break; }
+                if(!multinomial(n, ks, parts, &x)){ printf("Out of memory"); free(ks); break; }
+                printf("Multinomial(%ld) = ", n); printBig(&x);
+                bigFree(&x);
+                free(ks);
+                break;
+            case 6:
+                printf("Enter thread fork depth (0 = single thread, d = up to 2^d threads per tree): ");
+                scanf("%d",&maxDepth);
+                if(maxDepth < 0) maxDepth = 0;
+                break;
+            case 7:
+                printf("Enter number: ");
+                scanf("%ld",&n);
+                if(n >= 0 && n <= 100000) verify(n);
+                else printf("Invalid input");
+                break;
+            case 8: break;
+            default: printf("Invalid choice");
+        }
+    } while(choice!=8);
+    free(primes);
+    getch();
+}
@@ -0,0 +1,385 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+// Fibonacci and Lucas numbers by fast doubling:
+//
+//   F(2k)   = F(k) * (2F(k+1) - F(k))
+//   F(2k+1) = F(k)^2 + F(k+1)^2
+//   L(n)    = 2F(n+1) - F(n)
+//
+// so F(n) takes O(log n) multiplications instead of fibRec()'s
+// exponential recursion. Three modes:
+//   - exact 64-bit values from a table, F(0..93) and L(0..92)
+//   - F(n) mod m for any m < 2^63, using Montgomery multiplication when m
+//     is odd (no 128-bit division in the loop)
+//   - exact arbitrary-precision values, base 10^9 limbs with Karatsuba
+//     multiplication for large operands
+// plus range functions that get F(a), F(a+1) by doubling and then only add.
+
+#define MEMO 94
+#define BASE 1000000000u
+#define KARATSUBA 32    // limbs; below this schoolbook is faster
+#define MAX_N 100000000ULL   // largest n for exact values: F(n) has ~0.21n
+                             // digits, so limb counts stay far inside int
+
+typedef unsigned __int128 u128;
+
+uint64_t fibTable[MEMO], lucasTable[MEMO - 1];
+
+void initTables(){
+    int i;
+    fibTable[0] = 0; fibTable[1] = 1;
+    for(i = 2; i < MEMO; i++) fibTable[i] = fibTable[i-1] + fibTable[i-2];
+    for(i = 0; i < MEMO - 1; i++) lucasTable[i] = 2 * fibTable[i+1] - fibTable[i];
+}
+
+// ---------- Modular mode ----------
+
+struct Mod {
+    uint64_t m;
+    int mont;          // m odd: values are kept in Montgomery form x*2^64 mod m
+    uint64_t inv;      // -m^-1 mod 2^64
+};
+
+void modInit(struct Mod *md, uint64_t m){
+    uint64_t x = m;
+    int i;
+    md->m = m;
+    md->mont = m & 1;
+    if(md->mont){
+        for(i = 0; i < 5; i++) x *= 2 - m * x;   // Newton: m*x = 1 mod 2^64
+        md->inv = -x;
+    }
+}
+
+uint64_t redc(struct Mod *md, u128 t){   // t * 2^-64 mod m, for t < m * 2^64
+    uint64_t u = (uint64_t)t * md->inv;
+    uint64_t r = (uint64_t)((t + (u128)u * md->m) >> 64);
+    return r >= md->m ? r - md->m : r;
+}
+
+uint64_t mulMod(struct Mod *md, uint64_t a, uint64_t b){
+    if(md->mont) return redc(md, (u128)a * b);
+    return (uint64_t)((u128)a * b % md->m);
+}
+
+uint64_t toMod(struct Mod *md, uint64_t x){
+    if(md->mont) return (uint64_t)(((u128)(x % md->m) << 64) % md->m);
+    return x % md->m;
+}
+
+uint64_t fromMod(struct Mod *md, uint64_t x){
+    return md->mont ? redc(md, x) : x;
+}
+
+uint64_t addMod(struct Mod *md, uint64_t a, uint64_t b){ a += b; return a >= md->m ? a - md->m : a; }
+uint64_t subMod(struct Mod *md, uint64_t a, uint64_t b){ return a >= b ? a - b : a + md->m - b; }
+
+// F(n) and F(n+1) mod m, in the internal form of md
+void fibPairMod(struct Mod *md, uint64_t n, uint64_t *fn, uint64_t *fn1){
+    uint64_t a, b, c, d;
+    int bit;
+    if(n < MEMO - 1){ *fn = toMod(md, fibTable[n]); *fn1 = toMod(md, fibTable[n+1]); return; }
+    a = toMod(md, 0); b = toMod(md, 1);
+    for(bit = 63; bit >= 0; bit--){
+        c = mulMod(md, a, subMod(md, addMod(md, b, b), a));
+        d = addMod(md, mulMod(md, a, a), mulMod(md, b, b));
+        if((n >> bit) & 1){ a = d; b = addMod(md, c, d); }
+        else { a = c; b = d; }
+    }
+    *fn = a; *fn1 = b;
+}
+
+uint64_t fibMod(uint64_t n, uint64_t m){
+    struct Mod md;
+    uint64_t f, f1;
+    if(m == 1) return 0;
+    modInit(&md, m);
+    fibPairMod(&md, n, &f, &f1);
+    return fromMod(&md, f);
+}
+
+uint64_t lucasMod(uint64_t n, uint64_t m){
+    struct Mod md;
+    uint64_t f, f1;
+    if(m == 1) return 0;
+    modInit(&md, m);
+    fibPairMod(&md, n, &f, &f1);
+    return fromMod(&md, subMod(&md, addMod(&md, f1, f1), f));
+}
+
+// out[i] = F(a + i) mod m for 0 <= i <= b - a (counted from 0 so that
+// b = 2^64 - 1 does not loop forever)
+void fibRangeMod(uint64_t a, uint64_t b, uint64_t m, uint64_t *out){
+    uint64_t x, y, t, i;
+    struct Mod md;
+    if(m == 1){ for(i = 0; i <= b - a; i++) out[i] = 0; return; }
+    modInit(&md, m);
+    fibPairMod(&md, a, &x, &y);
+    x = fromMod(&md, x); y = fromMod(&md, y);
+    for(i = 0; i <= b - a; i++){
+        out[i] = x;
+        t = x + y >= m ? x + y - m : x + y;   // m < 2^63, so no overflow
+        x = y; y = t;
+    }
+}
+
+// ---------- Arbitrary precision ----------
+
+struct Big {
+    uint32_t *d;       // base 10^9 limbs, least significant first
+    int n, cap;        // n >= 1; zero is a single 0 limb
+};
+
+// Limb buffer of n words (zeroed if zero); exits like bigReserve if out
+// of memory
+uint32_t *newLimbs(int n, int zero){
+    uint32_t *p = (uint32_t*)(zero ? calloc(n, sizeof(uint32_t)) : malloc(n * sizeof(uint32_t)));
+    if(p == NULL){ printf("Out of memory\n"); exit(1); }
+    return p;
+}
+
+void bigInit(struct Big *x, uint32_t v){
+    x->cap = 4;
+    x->d = newLimbs(x->cap, 0);
+    x->d[0] = v;
+    x->n = 1;
+}
+
+void bigReserve(struct Big *x, int n){
+    uint32_t *d;
+    if(n <= x->cap) return;
+    x->cap = n * 2;
+    d = (uint32_t*)realloc(x->d, (size_t)x->cap * sizeof(uint32_t));
+    if(d == NULL){ printf("Out of memory\n"); exit(1); }
+    x->d = d;
+}
+
+void trim(struct Big *x){ while(x->n > 1 && x->d[x->n-1] == 0) x->n--; }
+
+// r = a + b (r may alias a or b)
+void bigAdd(struct Big *r, struct Big *a, struct Big *b){
+    int i, n = a->n > b->n ? a->n : b->n;
+    uint32_t carry = 0, s;
+    bigReserve(r, n + 1);
+    for(i = 0; i < n; i++){
+        s = (i < a->n ? a->d[i] : 0) + (i < b->n ? b->d[i] : 0) + carry;
+        carry = s >= BASE;
+        r->d[i] = carry ? s - BASE : s;
+    }
+    r->d[n] = carry;
+    r->n = n + 1;
+    trim(r);
+}
+
+// r = a - b, requires a >= b (r may alias a or b)
+void bigSub(struct Big *r, struct Big *a, struct Big *b){
+    int i, n = a->n;
+    int64_t s;
+    uint32_t borrow = 0;
+    bigReserve(r, n);
+    for(i = 0; i < n; i++){
+        s = (int64_t)a->d[i] - (i < b->n ? b->d[i] : 0) - borrow;
+        borrow = s < 0;
+        r->d[i] = (uint32_t)(borrow ? s + BASE : s);
+    }
+    r->n = n;
+    trim(r);
+}
+
+// dst[0..) += src[0..sn); dst must have room for the carry
+void addInto(uint32_t *dst, const uint32_t *src, int sn){
+    uint32_t carry = 0, s;
+    int i;
+    for(i = 0; i < sn || carry; i++){
+        s = dst[i] + (i < sn ? src[i] : 0) + carry;
+        carry = s >= BASE;
+        dst[i] = carry ? s - BASE : s;
+    }
+}
+
+// dst[0..dn) -= src[0..sn), result known to be non-negative
+void subInto(uint32_t *dst, const uint32_t *src, int sn){
+    int64_t s;
+    uint32_t borrow = 0;
+    int i;
+    for(i = 0; i < sn || borrow; i++){
+        s = (int64_t)dst[i] - (i < sn ? src[i] : 0) - borrow;
+        borrow = s < 0;
+        dst[i] = (uint32_t)(borrow ? s + BASE : s);
+    }
+}
+
+// out[0..na+nb) = a * b, out must not overlap a or b
+void mulRaw(const uint32_t *a, int na, const uint32_t *b, int nb, uint32_t *out){
+    const uint32_t *t;
+    uint32_t *s1, *s2, *z1;
+    uint64_t cur, carry;
+    int i, j, m, n1, n2;
+    if(na < nb){ t = a; a = b; b = t; i = na; na = nb; nb = i; }
+    memset(out, 0, (na + nb) * sizeof(uint32_t));
+    if(nb < KARATSUBA){   // schoolbook
+        for(i = 0; i < nb; i++){
+            carry = 0;
+            for(j = 0; j < na; j++){
+                cur = out[i+j] + (uint64_t)b[i] * a[j] + carry;
+                carry = cur / BASE;
+                out[i+j] = (uint32_t)(cur - carry * BASE);
+            }
+            out[i+na] = (uint32_t)carry;
+        }
+        return;
+    }
+    m = na / 2;
+    if(nb <= m){   // unbalanced: split only a
+        z1 = newLimbs(na - m + nb, 0);
+        mulRaw(a, m, b, nb, out);
+        mulRaw(a + m, na - m, b, nb, z1);
+        addInto(out + m, z1, na - m + nb);
+        free(z1);
+        return;
+    }
+    // a = a1*B^m + a0, b = b1*B^m + b0
+    // a*b = z2*B^2m + ((a0+a1)(b0+b1) - z0 - z2)*B^m + z0
+    n1 = na - m + 1;
+    n2 = (nb - m > m ? nb - m : m) + 1;
+    s1 = newLimbs(n1, 1);
+    s2 = newLimbs(n2, 1);
+    z1 = newLimbs(n1 + n2, 0);
+    memcpy(s1, a + m, (na - m) * sizeof(uint32_t)); addInto(s1, a, m);
+    memcpy(s2, b, m * sizeof(uint32_t)); addInto(s2, b + m, nb - m);
+    mulRaw(a, m, b, m, out);                          // z0
+    mulRaw(a + m, na - m, b + m, nb - m, out + 2*m);  // z2
+    mulRaw(s1, n1, s2, n2, z1);
+    subInto(z1, out, 2*m);
+    subInto(z1, out + 2*m, na + nb - 2*m);
+    for(i = n1 + n2; i > 0 && z1[i-1] == 0; i--);
+    addInto(out + m, z1, i);
+    free(s1); free(s2); free(z1);
+}
+
+// r = a * b (r may alias a or b)
+void bigMul(struct Big *r, struct Big *a, struct Big *b){
+    uint32_t *out = newLimbs(a->n + b->n, 0);
+    mulRaw(a->d, a->n, b->d, b->n, out);
+    free(r->d);
+    r->d = out;
+    r->n = r->cap = a->n + b->n;
+    trim(r);
+}
+
+void bigFree(struct Big *x){ free(x->d); }
+
+// F(n) and F(n+1) exactly
+void fibPairBig(uint64_t n, struct Big *fn, struct Big *fn1){
+    struct Big c, d, t, s;
+    int bit;
+    bigInit(&c, 0); bigInit(&d, 0); bigInit(&t, 0);
+    fn->d[0] = 0; fn->n = 1;
+    fn1->d[0] = 1; fn1->n = 1;
+    for(bit = 63; bit >= 0 && !(n >> bit); bit--);
+    for(; bit >= 0; bit--){
+        bigAdd(&t, fn1, fn1);       // c = F(k) * (2F(k+1) - F(k))
+        bigSub(&t, &t, fn);
+        bigMul(&c, fn, &t);
+        bigMul(&d, fn, fn);         // d = F(k)^2 + F(k+1)^2
+        bigMul(&t, fn1, fn1);
+        bigAdd(&d, &d, &t);
+        if((n >> bit) & 1){         // (F(2k+1), F(2k+2)) = (d, c + d)
+            bigAdd(&c, &c, &d);
+            s = *fn; *fn = d; d = s;
+            s = *fn1; *fn1 = c; c = s;
+        }
+        else {                      // (F(2k), F(2k+1)) = (c, d)
+            s = *fn; *fn = c; c = s;
+            s = *fn1; *fn1 = d; d = s;
+        }
+    }
+    bigFree(&c); bigFree(&d); bigFree(&t);
+}
+
+void printBig(struct Big *x){
+    char lead[16];
+    int i, digits = sprintf(lead, "%u", x->d[x->n-1]) + 9 * (x->n - 1);
+    if(digits <= 200){
+        printf("%s", lead);
+        for(i = x->n - 2; i >= 0; i--) printf("%09u", x->d[i]);
+    }
+    else {
+        printf("%s", lead);
+        for(i = x->n - 2; i >= x->n - 3; i--) printf("%09u", x->d[i]);
+        printf("...");
+        for(i = 2; i >= 0; i--) printf("%09u", x->d[i]);
+    }
+    printf(" (%d digits)", digits);
+}
+
+void main(){
+    struct Big f, f1, l;
+    uint64_t n, a, b, m, i, *out;
+    int choice;
+    clock_t t;
+    initTables();
+    clrscr();
+    do {
+        printf("\n1.F(n) and L(n) 2.F(n) and L(n) mod m 3.Range F(a..b) mod m 4.Range F(a..b) exact 5.Exit\nEnter choice: ");
+        if(scanf("%d",&choice) != 1) break;
+        switch(choice){
+            case 1:
+                printf("Enter n: ");
+                scanf("%llu",(unsigned long long*)&n);
+                if(n < MEMO - 1){ printf("F(%llu) = %llu\nL(%llu) = %llu\n", (unsigned long long)n, (unsigned long long)fibTable[n],
+                                        (unsigned long long)n, (unsigned long long)lucasTable[n]); break; }
+                if(n > MAX_N){ printf("Invalid input (exact values up to n = %llu; use option 2 for larger n)", MAX_N); break; }
+                bigInit(&f, 0); bigInit(&f1, 0); bigInit(&l, 0);
+                t = clock();
+                fibPairBig(n, &f, &f1);
+                printf("Time: %.3f s\n", (double)(clock() - t) / CLOCKS_PER_SEC);
+                bigAdd(&l, &f1, &f1);
+                bigSub(&l, &l, &f);
+                printf("F(%llu) = ", (unsigned long long)n); printBig(&f);
+                printf("\nL(%llu) = ", (unsigned long long)n); printBig(&l);
+                bigFree(&f); bigFree(&f1); bigFree(&l);
+                break;
+            case 2:
+                printf("Enter n and m (m < 2^63): ");
+                scanf("%llu %llu",(unsigned long long*)&n,(unsigned long long*)&m);
+                if(m == 0 || m >> 63){ printf("Invalid modulus"); break; }
+                printf("F(%llu) mod %llu = %llu\nL(%llu) mod %llu = %llu", (unsigned long long)n, (unsigned long long)m,
+                       (unsigned long long)fibMod(n, m), (unsigned long long)n, (unsigned long long)m, (unsigned long long)lucasMod(n, m));
+                break;
+            case 3:
+                printf("Enter a, b and m: ");
+                scanf("%llu %llu %llu",(unsigned long long*)&a,(unsigned long long*)&b,(unsigned long long*)&m);
+                if(m == 0 || m >> 63 || b < a || b - a >= 10000000){ printf("Invalid input"); break; }
+                out = (uint64_t*)malloc((b - a + 1) * sizeof(uint64_t));
+                if(out == NULL){ printf("Out of memory"); break; }
+                fibRangeMod(a, b, m, out);
+                for(i = 0; i <= b - a && i < 100; i++) printf("%llu ", (unsigned long long)out[i]);
+                if(b - a >= 100) printf("... F(%llu) mod m = %llu", (unsigned long long)b, (unsigned long long)out[b-a]);
+                free(out);
+                break;
+            case 4:
+                printf("Enter a and b: ");
+                scanf("%llu %llu",(unsigned long long*)&a,(unsigned long long*)&b);
+                if(b < a || b > MAX_N){ printf("Invalid input"); break; }
+                bigInit(&f, 0); bigInit(&f1, 0);
+                fibPairBig(a, &f, &f1);
+                for(i = a; ; i++){   // one addition per further term
+                    printf("F(%llu) = ", (unsigned long long)i); printBig(&f); printf("\n");
+                    if(i == b) break;   // not i <= b: b may be 2^64 - 1
+                    bigAdd(&f, &f, &f1);
+                    l = f; f = f1; f1 = l;
+                }
+                bigFree(&f); bigFree(&f1);
+                break;
+            case 5: break;
+            default: printf("Invalid choice");
+        }
+    } while(choice!=5);
+    getch();
+}
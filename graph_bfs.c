@@ -0,0 +1,433 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include "csr_graph.h"
+
+// Direction-optimizing breadth first search (Beamer, Asanovic and
+// Patterson) on a CSR graph, using several threads.
+//
+// A top-down step scans the edges leaving the frontier and claims each
+// unvisited neighbour with one CAS on its parent entry. A bottom-up step
+// instead loops over the unvisited vertices and scans their in-edges
+// until one of them is in the frontier; it stops at the first hit, so it
+// looks at far fewer edges once the frontier holds a large part of the
+// graph. The search starts top-down, switches to bottom-up when the edges
+// out of the frontier (mf) exceed the edges still unexplored (mu) divided
+// by ALPHA, and switches back once the frontier stops growing and holds
+// fewer than n / BETA vertices.
+//
+// Top-down frontiers are vertex queues. Each thread collects the vertices
+// it discovers in a small local buffer and appends the buffer to the
+// shared next queue with a single fetch-add. Bottom-up frontiers are
+// bitmaps, one bit per vertex. Bottom-up work is handed out in whole
+// 64-vertex words, so each thread owns the bitmap words and parent
+// entries it writes and no atomic read-modify-write is needed. The
+// threads stay alive for the whole search and meet at a barrier after
+// every step; thread 0 picks the direction for the next step.
+//
+// Uses pthread barriers and mmap (POSIX), so this program does not
+// include conio.h.
+
+#define ALPHA 15
+#define BETA 18
+#define MAX_THREADS 64
+#define LOCAL_BUF 1024       // vertices buffered per thread before a flush
+#define QUEUE_CHUNK 256      // frontier vertices claimed at a time
+#define WORD_CHUNK 16        // bitmap words (x64 vertices) claimed at a time
+
+enum { PH_INIT, PH_TOP_DOWN, PH_BOTTOM_UP, PH_CLEAR_FRONT, PH_QUEUE_TO_BITMAP, PH_BITMAP_TO_QUEUE, PH_EXIT };
+
+struct Local {
+    _Alignas(64) uint64_t awake, edges;   // vertices found, their out-degree sum
+    int len;
+    uint32_t buf[LOCAL_BUF];
+};
+
+struct BFS {
+    const struct Graph *out, *in;          // in == out for undirected graphs
+    _Atomic int32_t *parent;
+    _Atomic uint64_t *visited, *front, *next;
+    uint64_t words;
+    uint32_t *queue, *nextQueue;
+    uint64_t queueLen;
+    _Atomic uint64_t nextLen, cursor;
+    int threads, phase;
+    pthread_barrier_t barrier;
+    struct Local local[MAX_THREADS];
+};
+
+struct Worker {
+    struct BFS *b;
+    int id;
+};
+
+struct Stats {
+    int levels, bottomUpSteps;
+    uint64_t reached, edges;
+    double seconds;
+};
+
+int threads = 4;
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// ---------- Frontier helpers ----------
+
+void flushLocal(struct BFS *b, struct Local *l) {
+    uint64_t at = atomic_fetch_add_explicit(&b->nextLen, l->len, memory_order_relaxed);
+    memcpy(b->nextQueue + at, l->buf, l->len * sizeof(uint32_t));
+    l->len = 0;
+}
+
+void pushLocal(struct BFS *b, struct Local *l, uint32_t v) {
+    if (l->len == LOCAL_BUF) flushLocal(b, l);
+    l->buf[l->len++] = v;
+}
+
+// Claim [*lo, *hi) of size chunk from 0..limit; 0 when nothing is left
+int claim(struct BFS *b, uint64_t chunk, uint64_t limit, uint64_t *lo, uint64_t *hi) {
+    *lo = atomic_fetch_add_explicit(&b->cursor, chunk, memory_order_relaxed);
+    if (*lo >= limit) return 0;
+    *hi = *lo + chunk < limit ? *lo + chunk : limit;
+    return 1;
+}
+
+// ---------- Steps ----------
+
+void topDownStep(struct BFS *b, struct Local *l) {
+    const struct Graph *g = b->out;
+    uint64_t lo, hi, i, e;
+    int32_t none;
+    uint32_t u, v;
+    while (claim(b, QUEUE_CHUNK, b->queueLen, &lo, &hi))
+        for (i = lo; i < hi; i++) {
+            u = b->queue[i];
+            for (e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+                v = g->adj[e];
+                if (atomic_load_explicit(&b->parent[v], memory_order_relaxed) >= 0) continue;
+                none = -1;
+                if (atomic_compare_exchange_strong_explicit(&b->parent[v], &none, (int32_t)u,
+                                                            memory_order_relaxed, memory_order_relaxed)) {
+                    atomic_fetch_or_explicit(&b->visited[v >> 6], 1ULL << (v & 63), memory_order_relaxed);
+                    pushLocal(b, l, v);
+                    l->awake++;
+                    l->edges += graphDegree(g, v);
+                }
+            }
+        }
+    flushLocal(b, l);
+}
+
+void bottomUpStep(struct BFS *b, struct Local *l) {
+    const struct Graph *g = b->in;
+    uint64_t lo, hi, w, e, seen, fresh, bits;
+    uint32_t v, u;
+    while (claim(b, WORD_CHUNK, b->words, &lo, &hi))
+        for (w = lo; w < hi; w++) {
+            seen = atomic_load_explicit(&b->visited[w], memory_order_relaxed);
+            fresh = 0;
+            for (bits = ~seen; bits; bits &= bits - 1) {
+                v = (uint32_t)(w * 64 + __builtin_ctzll(bits));
+                if (v >= g->n) break;
+                for (e = g->offsets[v]; e < g->offsets[v + 1]; e++) {
+                    u = g->adj[e];
+                    if (atomic_load_explicit(&b->front[u >> 6], memory_order_relaxed) >> (u & 63) & 1) {
+                        atomic_store_explicit(&b->parent[v], (int32_t)u, memory_order_relaxed);
+                        fresh |= 1ULL << (v & 63);
+                        l->awake++;
+                        l->edges += graphDegree(b->out, v);
+                        break;
+                    }
+                }
+            }
+            atomic_store_explicit(&b->next[w], fresh, memory_order_relaxed);
+            if (fresh) atomic_store_explicit(&b->visited[w], seen | fresh, memory_order_relaxed);
+        }
+}
+
+void runPhase(struct BFS *b, struct Local *l) {
+    uint64_t lo, hi, i, bits;
+    switch (b->phase) {
+        case PH_INIT:
+            while (claim(b, WORD_CHUNK, b->words, &lo, &hi)) {
+                for (i = lo; i < hi; i++) atomic_store_explicit(&b->visited[i], 0, memory_order_relaxed);
+                for (i = lo * 64; i < hi * 64 && i < b->out->n; i++)
+                    atomic_store_explicit(&b->parent[i], -1, memory_order_relaxed);
+            }
+            break;
+        case PH_TOP_DOWN: topDownStep(b, l); break;
+        case PH_BOTTOM_UP: bottomUpStep(b, l); break;
+        case PH_CLEAR_FRONT:
+            while (claim(b, WORD_CHUNK, b->words, &lo, &hi))
+                for (i = lo; i < hi; i++) atomic_store_explicit(&b->front[i], 0, memory_order_relaxed);
+            break;
+        case PH_QUEUE_TO_BITMAP:
+            while (claim(b, QUEUE_CHUNK, b->queueLen, &lo, &hi))
+                for (i = lo; i < hi; i++)
+                    atomic_fetch_or_explicit(&b->front[b->queue[i] >> 6], 1ULL << (b->queue[i] & 63), memory_order_relaxed);
+            break;
+        case PH_BITMAP_TO_QUEUE:
+            while (claim(b, WORD_CHUNK, b->words, &lo, &hi))
+                for (i = lo; i < hi; i++)
+                    for (bits = atomic_load_explicit(&b->front[i], memory_order_relaxed); bits; bits &= bits - 1)
+                        pushLocal(b, l, (uint32_t)(i * 64 + __builtin_ctzll(bits)));
+            flushLocal(b, l);
+            break;
+    }
+}
+
+void *worker(void *arg) {
+    struct Worker *w = (struct Worker*)arg;
+    for (;;) {
+        pthread_barrier_wait(&w->b->barrier);   // phase is set
+        if (w->b->phase == PH_EXIT) return NULL;
+        runPhase(w->b, &w->b->local[w->id]);
+        pthread_barrier_wait(&w->b->barrier);   // phase is done
+    }
+}
+
+// Run one phase on all threads (thread 0 is the caller); returns the
+// vertices and edges found, summed over the threads
+void phase(struct BFS *b, int ph, uint64_t *awake, uint64_t *edges) {
+    int t;
+    b->phase = ph;
+    atomic_store(&b->cursor, 0);
+    atomic_store(&b->nextLen, 0);
+    for (t = 0; t < b->threads; t++) b->local[t].awake = b->local[t].edges = 0;
+    pthread_barrier_wait(&b->barrier);
+    runPhase(b, &b->local[0]);
+    pthread_barrier_wait(&b->barrier);
+    *awake = *edges = 0;
+    for (t = 0; t < b->threads; t++) { *awake += b->local[t].awake; *edges += b->local[t].edges; }
+}
+
+void swapQueues(struct BFS *b) {
+    uint32_t *t = b->queue;
+    b->queue = b->nextQueue;
+    b->nextQueue = t;
+    b->queueLen = atomic_load(&b->nextLen);
+}
+
+// BFS from source. parent[v] is v's BFS parent, source for the source and
+// -1 if v is unreachable. With directionOptimizing = 0 every step is
+// top-down (for comparison). in is the transposed graph, or out itself for
+// an undirected graph. Returns 0 if the work buffers cannot be allocated.
+int bfs(const struct Graph *out, const struct Graph *in, uint32_t source, int32_t *parentOut,
+        int directionOptimizing, struct Stats *stats) {
+    struct BFS *b = (struct BFS*)calloc(1, sizeof(struct BFS));
+    struct Worker w[MAX_THREADS];
+    pthread_t th[MAX_THREADS];
+    struct Stats st = { 0, 0, 1, 0, 0 };
+    uint64_t n = out->n, awake, edges, oldAwake, scout, unexplored = out->m;
+    _Atomic uint64_t *t;
+    int k;
+    double start = now();
+    if (b == NULL) return 0;
+    b->out = out;
+    b->in = in;
+    b->threads = threads;
+    b->words = (n + 63) / 64;
+    b->parent = (_Atomic int32_t*)parentOut;
+    b->visited = (_Atomic uint64_t*)calloc(b->words, sizeof(uint64_t));
+    b->front = (_Atomic uint64_t*)calloc(b->words, sizeof(uint64_t));
+    b->next = (_Atomic uint64_t*)calloc(b->words, sizeof(uint64_t));
+    b->queue = (uint32_t*)malloc(n * sizeof(uint32_t));
+    b->nextQueue = (uint32_t*)malloc(n * sizeof(uint32_t));
+    if (b->visited == NULL || b->front == NULL || b->next == NULL || b->queue == NULL || b->nextQueue == NULL) {
+        free((void*)b->visited); free((void*)b->front); free((void*)b->next);
+        free(b->queue); free(b->nextQueue);
+        free(b);
+        return 0;
+    }
+    pthread_barrier_init(&b->barrier, NULL, threads);
+    for (k = 1; k < threads; k++) {
+        w[k].b = b;
+        w[k].id = k;
+        pthread_create(&th[k], NULL, worker, &w[k]);
+    }
+    phase(b, PH_INIT, &awake, &edges);
+    atomic_store(&b->parent[source], (int32_t)source);
+    atomic_store(&b->visited[source >> 6], 1ULL << (source & 63));
+    b->queue[0] = source;
+    b->queueLen = 1;
+    scout = graphDegree(out, source);
+    st.edges = scout;
+
+    while (b->queueLen) {
+        if (directionOptimizing && scout > unexplored / ALPHA) {
+            phase(b, PH_CLEAR_FRONT, &awake, &edges);
+            phase(b, PH_QUEUE_TO_BITMAP, &awake, &edges);
+            awake = b->queueLen;
+            do {
+                oldAwake = awake;
+                phase(b, PH_BOTTOM_UP, &awake, &edges);
+                t = b->front; b->front = b->next; b->next = t;
+                st.levels += awake > 0;
+                st.bottomUpSteps++;
+                st.reached += awake;
+                st.edges += edges;
+                unexplored -= edges < unexplored ? edges : unexplored;
+            } while (awake && (awake >= oldAwake || awake > n / BETA));
+            phase(b, PH_BITMAP_TO_QUEUE, &awake, &edges);
+            swapQueues(b);
+            scout = 1;   // take a top-down step next, as in the reference code
+        }
+        else {
+            unexplored -= scout < unexplored ? scout : unexplored;
+            phase(b, PH_TOP_DOWN, &awake, &edges);
+            swapQueues(b);
+            st.levels += awake > 0;
+            st.reached += awake;
+            st.edges += edges;
+            scout = edges;
+        }
+    }
+    b->phase = PH_EXIT;
+    pthread_barrier_wait(&b->barrier);
+    for (k = 1; k < threads; k++) pthread_join(th[k], NULL);
+    pthread_barrier_destroy(&b->barrier);
+    st.seconds = now() - start;
+    free((void*)b->visited); free((void*)b->front); free((void*)b->next);
+    free(b->queue); free(b->nextQueue);
+    free(b);
+    *stats = st;
+    return 1;
+}
+
+// ---------- Checking ----------
+
+int hasEdge(const struct Graph *g, uint32_t u, uint32_t v) {   // lists are sorted
+    uint64_t lo = g->offsets[u], hi = g->offsets[u + 1], mid;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (g->adj[mid] < v) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo < g->offsets[u + 1] && g->adj[lo] == v;
+}
+
+// Compare with a plain serial queue BFS: the same vertices must be reached
+// and every parent must be an edge from the level just above. Returns -1
+// if out of memory.
+int verify(const struct Graph *g, uint32_t source, const int32_t *parent) {
+    int32_t *depth = (int32_t*)malloc(g->n * sizeof(int32_t));
+    uint32_t *queue = (uint32_t*)malloc(g->n * sizeof(uint32_t)), u, v;
+    uint64_t front = 0, rear = 0, e, i;
+    int ok = 1;
+    if (depth == NULL || queue == NULL) { free(depth); free(queue); return -1; }
+    for (i = 0; i < g->n; i++) depth[i] = -1;
+    depth[source] = 0;
+    queue[rear++] = source;
+    while (front < rear) {
+        u = queue[front++];
+        for (e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            v = g->adj[e];
+            if (depth[v] < 0) { depth[v] = depth[u] + 1; queue[rear++] = v; }
+        }
+    }
+    for (v = 0; v < g->n && ok; v++) {
+        if ((depth[v] < 0) != (parent[v] < 0)) ok = 0;
+        else if (v == source) ok = parent[v] == (int32_t)source;
+        else if (depth[v] > 0)
+            ok = depth[parent[v]] == depth[v] - 1 && hasEdge(g, (uint32_t)parent[v], v);
+    }
+    free(depth);
+    free(queue);
+    return ok;
+}
+
+void printStats(const char *name, struct Stats st) {
+    printf("%-24s %8.3f ms  %d levels (%d bottom-up)  %llu vertices  %.1f MTEPS\n", name, st.seconds * 1e3,
+           st.levels, st.bottomUpSteps, (unsigned long long)st.reached, st.edges / st.seconds * 1e-6);
+}
+
+int main() {
+    struct EdgeList el;
+    struct Graph out = { 0 }, in = { 0 };
+    int32_t *parent = NULL;
+    int choice, scale, factor, undirected = 1, runs, r, ok;
+    unsigned source;
+    char path[256];
+    uint64_t seed = 1;
+    struct Stats st;
+    double t;
+    do {
+        printf("\n1.Generate R-MAT Graph 2.Load Edge List 3.Run BFS 4.Benchmark 5.Verify 6.Set Threads 7.Exit\nEnter choice: ");
+        if (scanf("%d", &choice) != 1) break;
+        switch (choice) {
+            case 1:
+            case 2:
+                if (choice == 1) {
+                    printf("Enter scale (log2 vertices) and edge factor: ");
+                    scanf("%d %d", &scale, &factor);
+                    ok = edgeListRmat(&el, scale, factor, seed++);
+                }
+                else {
+                    printf("Enter edge list file: ");
+                    scanf("%255s", path);
+                    ok = edgeListLoad(&el, path);
+                }
+                printf("Undirected (1/0): ");
+                scanf("%d", &undirected);
+                if (!ok) { printf("Could not read the edges"); edgeListFree(&el); break; }
+                t = now();
+                if (in.adj != out.adj) graphFree(&in);
+                graphFree(&out);
+                free(parent);
+                ok = graphBuild(&out, &el, undirected ? GRAPH_UNDIRECTED : 0);
+                if (ok && !undirected) ok = graphBuild(&in, &el, GRAPH_TRANSPOSE);
+                else in = out;
+                edgeListFree(&el);
+                parent = ok ? (int32_t*)malloc((out.n ? out.n : 1) * sizeof(int32_t)) : NULL;
+                if (!ok || parent == NULL) { printf("Out of memory"); graphFree(&out); in = out; break; }
+                printf("Built CSR graph: %u vertices, %llu edges in %.3f s", out.n, (unsigned long long)out.m, now() - t);
+                break;
+            case 3:
+            case 5:
+                if (out.n == 0) { printf("No graph loaded"); break; }
+                printf("Enter source vertex: ");
+                scanf("%u", &source);
+                if (source >= out.n) { printf("Invalid vertex"); break; }
+                if (!bfs(&out, &in, source, parent, 1, &st)) { printf("Out of memory"); break; }
+                if (choice == 3) printStats("Direction-optimizing:", st);
+                else {
+                    ok = verify(&out, source, parent);
+                    printf("%s", ok < 0 ? "Out of memory" : ok ? "BFS tree verified" : "VERIFY FAILED");
+                }
+                break;
+            case 4:
+                if (out.n == 0) { printf("No graph loaded"); break; }
+                printf("Enter number of random sources: ");
+                scanf("%d", &runs);
+                for (r = 0; r < runs; r++) {
+                    do source = (unsigned)(graphRandom(&seed) % out.n);
+                    while (graphDegree(&out, source) == 0);
+                    printf("Source %u\n", source);
+                    if (!bfs(&out, &in, source, parent, 0, &st)) { printf("Out of memory"); break; }
+                    printStats("  Top-down only:", st);
+                    if (!bfs(&out, &in, source, parent, 1, &st)) { printf("Out of memory"); break; }
+                    printStats("  Direction-optimizing:", st);
+                }
+                break;
+            case 6:
+                printf("Enter number of threads: ");
+                scanf("%d", &threads);
+                if (threads < 1) threads = 1;
+                if (threads > MAX_THREADS) threads = MAX_THREADS;
+                break;
+            case 7: break;
+            default: printf("Invalid choice");
+        }
+    } while (choice != 7);
+    if (in.adj != out.adj) graphFree(&in);
+    graphFree(&out);
+    free(parent);
+    return 0;
+}
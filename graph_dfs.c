@@ -0,0 +1,508 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include "csr_graph.h"
+
+// Depth first search without recursion on a CSR graph, and the usual
+// algorithms built on it: strongly connected components, topological
+// sort and connected components.
+//
+// The call stack is an explicit array of (vertex, edge cursor) frames:
+// the cursor is the position in adj[] of the next edge to try, so
+// resuming a vertex after a child returns is O(1) and the depth of the
+// graph is limited only by memory, not by the thread stack. Visited
+// flags are a bitset (V/8 bytes). Frames are 12 bytes; the stack grows by
+// doubling but its capacity is capped at V frames (a vertex is marked
+// before it is pushed, so it is never on the stack twice), so a search
+// never needs more than 12V bytes of stack.
+//
+// SCCs use Pearce's space-efficient form of Tarjan's algorithm: a single
+// array rindex[] holds a vertex's DFS index while it is open and its
+// component number once it is assigned, replacing Tarjan's separate
+// index, lowlink and on-stack arrays. Memory is 4V bytes for rindex, a
+// V-bit root bitset, and at most 4V for the component stack plus 12V for
+// the call stack. Components come out in reverse topological order.
+//
+// Connected components are found either by DFS or by a concurrent
+// union-find: threads take ranges of vertices and union the endpoints of
+// their edges with CAS links (larger root under smaller) and
+// path halving.
+//
+// Uses pthreads and mmap (POSIX), so this program does not include
+// conio.h.
+
+#define MAX_THREADS 64
+#define VERTEX_CHUNK 4096
+
+struct Stack {
+    uint32_t *vtx;
+    uint64_t *cur;
+    uint64_t top, cap;
+};
+
+int threads = 4;
+uint64_t peakFrames;
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// ---------- Bitset and stack ----------
+
+uint64_t *newBitset(uint64_t n) {
+    return (uint64_t*)calloc((n + 63) / 64 + 1, sizeof(uint64_t));
+}
+
+int testBit(const uint64_t *b, uint32_t i) { return b[i >> 6] >> (i & 63) & 1; }
+void setBit(uint64_t *b, uint32_t i) { b[i >> 6] |= 1ULL << (i & 63); }
+void clearBit(uint64_t *b, uint32_t i) { b[i >> 6] &= ~(1ULL << (i & 63)); }
+
+void push(struct Stack *s, const struct Graph *g, uint32_t v) {
+    if (s->top == s->cap) {
+        s->cap = s->cap ? s->cap * 2 : 1024;
+        if (s->cap > g->n) s->cap = g->n;   // top < n here: no vertex is pushed twice
+        s->vtx = (uint32_t*)realloc(s->vtx, s->cap * sizeof(uint32_t));
+        s->cur = (uint64_t*)realloc(s->cur, s->cap * sizeof(uint64_t));
+        if (s->vtx == NULL || s->cur == NULL) { printf("\nOut of memory"); exit(1); }
+    }
+    s->vtx[s->top] = v;
+    s->cur[s->top++] = g->offsets[v];
+    if (s->top > peakFrames) peakFrames = s->top;
+}
+
+void freeStack(struct Stack *s) {
+    free(s->vtx);
+    free(s->cur);
+}
+
+// ---------- DFS ----------
+
+// Preorder from source, neighbours in increasing order (the order the
+// recursive version visits them in). Writes up to limit vertices to out
+// and returns how many were reached.
+uint64_t dfsPreorder(const struct Graph *g, uint32_t source, uint32_t *out, uint64_t limit) {
+    struct Stack s = { 0 };
+    uint64_t *visited = newBitset(g->n), count = 0;
+    uint32_t v, w;
+    setBit(visited, source);
+    if (limit) out[0] = source;
+    count = 1;
+    push(&s, g, source);
+    while (s.top) {
+        v = s.vtx[s.top - 1];
+        if (s.cur[s.top - 1] == g->offsets[v + 1]) { s.top--; continue; }
+        w = g->adj[s.cur[s.top - 1]++];
+        if (testBit(visited, w)) continue;
+        setBit(visited, w);
+        if (count < limit) out[count] = w;
+        count++;
+        push(&s, g, w);
+    }
+    free(visited);
+    freeStack(&s);
+    return count;
+}
+
+// comp[v] = SCC number, 0 .. count-1 in reverse topological order of the
+// condensation (an edge u->v between components has comp[u] > comp[v]).
+// Returns the number of components.
+uint32_t stronglyConnected(const struct Graph *g, uint32_t *comp) {
+    struct Stack s = { 0 };
+    uint32_t *rindex = comp, *open = (uint32_t*)malloc((g->n ? g->n : 1) * sizeof(uint32_t));
+    uint64_t *root = newBitset(g->n), openTop = 0;
+    uint32_t index = 1, c = g->n - 1, v, w, r;
+    for (r = 0; r < g->n; r++) rindex[r] = 0;
+    for (r = 0; r < g->n; r++) {
+        if (rindex[r]) continue;
+        rindex[r] = index++;
+        setBit(root, r);
+        push(&s, g, r);
+        while (s.top) {
+            v = s.vtx[s.top - 1];
+            if (s.cur[s.top - 1] < g->offsets[v + 1]) {
+                w = g->adj[s.cur[s.top - 1]];
+                if (rindex[w] == 0) {           // tree edge: descend, check w on return
+                    rindex[w] = index++;
+                    setBit(root, w);
+                    push(&s, g, w);
+                    continue;
+                }
+                if (rindex[w] < rindex[v]) { rindex[v] = rindex[w]; clearBit(root, v); }
+                s.cur[s.top - 1]++;
+                continue;
+            }
+            s.top--;                             // v is finished
+            if (testBit(root, v)) {              // v heads a component
+                index--;
+                while (openTop && rindex[v] <= rindex[open[openTop - 1]]) {
+                    rindex[open[--openTop]] = c;
+                    index--;
+                }
+                rindex[v] = c--;
+            }
+            else open[openTop++] = v;
+        }
+    }
+    for (v = 0; v < g->n; v++) comp[v] = g->n - 1 - rindex[v];
+    free(open);
+    free(root);
+    freeStack(&s);
+    return g->n - 1 - c;
+}
+
+// order[] = vertices so that every edge goes forward. Returns 0 if the
+// graph has a cycle (order is then incomplete).
+int topologicalSort(const struct Graph *g, uint32_t *order) {
+    struct Stack s = { 0 };
+    uint64_t *visited = newBitset(g->n), *done = newBitset(g->n);
+    uint64_t pos = g->n;
+    uint32_t r, v, w;
+    int ok = 1;
+    for (r = 0; r < g->n && ok; r++) {
+        if (testBit(visited, r)) continue;
+        setBit(visited, r);
+        push(&s, g, r);
+        while (s.top && ok) {
+            v = s.vtx[s.top - 1];
+            if (s.cur[s.top - 1] == g->offsets[v + 1]) {   // postorder: place v before
+                s.top--;                                    // everything it reaches
+                setBit(done, v);
+                order[--pos] = v;
+                continue;
+            }
+            w = g->adj[s.cur[s.top - 1]++];
+            if (!testBit(visited, w)) { setBit(visited, w); push(&s, g, w); }
+            else if (!testBit(done, w)) ok = 0;             // back edge
+        }
+    }
+    free(visited);
+    free(done);
+    freeStack(&s);
+    return ok;
+}
+
+// comp[v] = smallest vertex of v's component, for an undirected graph
+uint32_t componentsDFS(const struct Graph *g, uint32_t *comp) {
+    struct Stack s = { 0 };
+    uint64_t *visited = newBitset(g->n);
+    uint32_t r, v, w, count = 0;
+    for (r = 0; r < g->n; r++) {
+        if (testBit(visited, r)) continue;
+        count++;
+        setBit(visited, r);
+        comp[r] = r;
+        push(&s, g, r);
+        while (s.top) {
+            v = s.vtx[s.top - 1];
+            if (s.cur[s.top - 1] == g->offsets[v + 1]) { s.top--; continue; }
+            w = g->adj[s.cur[s.top - 1]++];
+            if (!testBit(visited, w)) { setBit(visited, w); comp[w] = r; push(&s, g, w); }
+        }
+    }
+    free(visited);
+    freeStack(&s);
+    return count;
+}
+
+// ---------- Parallel union-find ----------
+
+struct UnionFind {
+    const struct Graph *g;
+    _Atomic uint32_t *parent;
+    _Atomic uint64_t cursor;
+};
+
+uint32_t findRoot(_Atomic uint32_t *parent, uint32_t x) {
+    uint32_t p, gp;
+    while ((p = atomic_load_explicit(&parent[x], memory_order_relaxed)) != x) {
+        gp = atomic_load_explicit(&parent[p], memory_order_relaxed);
+        if (gp != p)   // path halving; losing the race is harmless
+            atomic_compare_exchange_weak_explicit(&parent[x], &p, gp, memory_order_relaxed, memory_order_relaxed);
+        x = gp;
+    }
+    return x;
+}
+
+void unite(_Atomic uint32_t *parent, uint32_t u, uint32_t v) {
+    uint32_t t;
+    for (;;) {
+        u = findRoot(parent, u);
+        v = findRoot(parent, v);
+        if (u == v) return;
+        if (u < v) { t = u; u = v; v = t; }   // link the larger root under the smaller
+        t = u;
+        if (atomic_compare_exchange_strong_explicit(&parent[u], &t, v, memory_order_relaxed, memory_order_relaxed))
+            return;
+    }
+}
+
+void *unionWorker(void *arg) {
+    struct UnionFind *uf = (struct UnionFind*)arg;
+    const struct Graph *g = uf->g;
+    uint64_t lo, hi, e;
+    uint32_t u;
+    for (;;) {
+        lo = atomic_fetch_add(&uf->cursor, VERTEX_CHUNK);
+        if (lo >= g->n) return NULL;
+        hi = lo + VERTEX_CHUNK < g->n ? lo + VERTEX_CHUNK : g->n;
+        for (u = (uint32_t)lo; u < hi; u++)
+            for (e = g->offsets[u]; e < g->offsets[u + 1]; e++)
+                if (g->adj[e] != u) unite(uf->parent, u, g->adj[e]);
+    }
+}
+
+void *compressWorker(void *arg) {
+    struct UnionFind *uf = (struct UnionFind*)arg;
+    uint64_t lo, hi, v;
+    for (;;) {
+        lo = atomic_fetch_add(&uf->cursor, VERTEX_CHUNK);
+        if (lo >= uf->g->n) return NULL;
+        hi = lo + VERTEX_CHUNK < uf->g->n ? lo + VERTEX_CHUNK : uf->g->n;
+        for (v = lo; v < hi; v++)
+            atomic_store_explicit(&uf->parent[v], findRoot(uf->parent, (uint32_t)v), memory_order_relaxed);
+    }
+}
+
+void runWorkers(struct UnionFind *uf, void *(*fn)(void*)) {
+    pthread_t th[MAX_THREADS];
+    int k;
+    atomic_store(&uf->cursor, 0);
+    for (k = 1; k < threads; k++) pthread_create(&th[k], NULL, fn, uf);
+    fn(uf);
+    for (k = 1; k < threads; k++) pthread_join(th[k], NULL);
+}
+
+// comp[v] = smallest vertex of v's (weakly) connected component
+uint32_t componentsUnionFind(const struct Graph *g, uint32_t *comp) {
+    struct UnionFind uf;
+    uint32_t v, count = 0;
+    uf.g = g;
+    uf.parent = (_Atomic uint32_t*)comp;
+    for (v = 0; v < g->n; v++) atomic_init(&uf.parent[v], v);
+    runWorkers(&uf, unionWorker);
+    runWorkers(&uf, compressWorker);
+    for (v = 0; v < g->n; v++) count += comp[v] == v;
+    return count;
+}
+
+// ---------- Test graphs and checking ----------
+
+// DAG of depth n: a chain through a random permutation of the vertices
+// plus extra random edges that go forward along the chain
+int edgeListDeepDag(struct EdgeList *el, uint32_t n, uint64_t extra, uint64_t seed) {
+    uint32_t *perm = (uint32_t*)malloc((n ? n : 1) * sizeof(uint32_t)), i, r, t, a, b;
+    uint64_t e, state = seed;
+    int ok = perm != NULL;
+    memset(el, 0, sizeof(*el));
+    for (i = 0; i < n && ok; i++) perm[i] = i;
+    for (i = n; i > 1 && ok; i--) {
+        r = (uint32_t)(graphRandom(&state) % i);
+        t = perm[i - 1]; perm[i - 1] = perm[r]; perm[r] = t;
+    }
+    for (i = 0; i + 1 < n && ok; i++) ok = edgeListAdd(el, perm[i], perm[i + 1]);
+    for (e = 0; e < extra && ok && n > 1; e++) {
+        a = (uint32_t)(graphRandom(&state) % n);
+        b = (uint32_t)(graphRandom(&state) % n);
+        if (a != b) ok = edgeListAdd(el, perm[a < b ? a : b], perm[a < b ? b : a]);
+    }
+    free(perm);
+    return ok;
+}
+
+// Same partition: comp labels must map one to one
+int samePartition(const uint32_t *a, const uint32_t *b, uint32_t n) {
+    uint32_t *map = (uint32_t*)malloc((n ? n : 1) * sizeof(uint32_t)), v;
+    int ok = 1;
+    for (v = 0; v < n; v++) map[v] = UINT32_MAX;
+    for (v = 0; v < n && ok; v++) {
+        if (map[a[v]] == UINT32_MAX) map[a[v]] = b[v];
+        else if (map[a[v]] != b[v]) ok = 0;
+    }
+    free(map);
+    return ok;
+}
+
+// Kosaraju with the same iterative DFS: postorder on g, then trees of
+// the transpose in reverse postorder are the SCCs
+uint32_t kosaraju(const struct Graph *g, const struct Graph *t, uint32_t *comp) {
+    uint32_t *order = (uint32_t*)malloc((g->n ? g->n : 1) * sizeof(uint32_t)), r, v, w, count = 0;
+    uint64_t *visited = newBitset(g->n), pos = 0, i;
+    struct Stack s = { 0 };
+    for (r = 0; r < g->n; r++) {
+        if (testBit(visited, r)) continue;
+        setBit(visited, r);
+        push(&s, g, r);
+        while (s.top) {
+            v = s.vtx[s.top - 1];
+            if (s.cur[s.top - 1] == g->offsets[v + 1]) { order[pos++] = v; s.top--; continue; }
+            w = g->adj[s.cur[s.top - 1]++];
+            if (!testBit(visited, w)) { setBit(visited, w); push(&s, g, w); }
+        }
+    }
+    memset(visited, 0, ((g->n + 63) / 64 + 1) * sizeof(uint64_t));
+    for (i = g->n; i-- > 0;) {
+        r = order[i];
+        if (testBit(visited, r)) continue;
+        setBit(visited, r);
+        comp[r] = count;
+        push(&s, t, r);
+        while (s.top) {
+            v = s.vtx[s.top - 1];
+            if (s.cur[s.top - 1] == t->offsets[v + 1]) { s.top--; continue; }
+            w = t->adj[s.cur[s.top - 1]++];
+            if (!testBit(visited, w)) { setBit(visited, w); comp[w] = count; push(&s, t, w); }
+        }
+        count++;
+    }
+    free(order);
+    free(visited);
+    freeStack(&s);
+    return count;
+}
+
+int verify(const struct Graph *g, const struct EdgeList *el, int undirected) {
+    uint32_t *a = (uint32_t*)malloc((g->n ? g->n : 1) * sizeof(uint32_t));
+    uint32_t *b = (uint32_t*)malloc((g->n ? g->n : 1) * sizeof(uint32_t)), u, ca, cb;
+    uint64_t e;
+    struct Graph t;
+    int ok = 1;
+    ca = stronglyConnected(g, a);
+    for (u = 0; u < g->n && ok; u++)     // condensation edges go to lower numbers
+        for (e = g->offsets[u]; e < g->offsets[u + 1]; e++)
+            if (a[u] < a[g->adj[e]]) ok = 0;
+    if (!ok) printf("SCC numbering is not reverse topological\n");
+    if (ok && graphBuild(&t, el, undirected ? GRAPH_UNDIRECTED : GRAPH_TRANSPOSE)) {
+        cb = kosaraju(g, &t, b);
+        graphFree(&t);
+        if (ca != cb || !samePartition(a, b, g->n) || !samePartition(b, a, g->n)) { printf("SCCs differ from Kosaraju\n"); ok = 0; }
+    }
+    if (ok && topologicalSort(g, b)) {   // every edge must go forward
+        for (u = 0; u < g->n; u++) a[b[u]] = u;
+        for (u = 0; u < g->n && ok; u++)
+            for (e = g->offsets[u]; e < g->offsets[u + 1]; e++)
+                if (a[u] >= a[g->adj[e]]) ok = 0;
+        if (!ok) printf("Topological order has a backward edge\n");
+    }
+    if (ok && undirected) {
+        ca = componentsDFS(g, a);
+        cb = componentsUnionFind(g, b);
+        for (u = 0; u < g->n && ok; u++) ok = a[u] == b[u];
+        if (!ok || ca != cb) { printf("DFS and union-find components differ\n"); ok = 0; }
+    }
+    free(a);
+    free(b);
+    return ok;
+}
+
+int main() {
+    struct EdgeList el = { 0 };
+    struct Graph g = { 0 };
+    uint32_t *out = NULL, count, u;
+    uint64_t seed = 1, reached, i;
+    unsigned long long extra;
+    int choice, scale, factor, undirected = 0, ok;
+    unsigned n, source;
+    char path[256];
+    double t;
+    do {
+        printf("\n1.Generate R-MAT Graph 2.Generate Deep DAG 3.Load Edge List 4.DFS Order 5.Strongly Connected Components"
+               "\n6.Topological Sort 7.Connected Components 8.Verify 9.Set Threads 10.Exit\nEnter choice: ");
+        if (scanf("%d", &choice) != 1) break;
+        switch (choice) {
+            case 1:
+            case 2:
+            case 3:
+                edgeListFree(&el);
+                if (choice == 1) {
+                    printf("Enter scale (log2 vertices) and edge factor: ");
+                    scanf("%d %d", &scale, &factor);
+                    ok = edgeListRmat(&el, scale, factor, seed++);
+                }
+                else if (choice == 2) {
+                    printf("Enter number of vertices and extra edges: ");
+                    scanf("%u %llu", &n, &extra);
+                    ok = n < INT32_MAX && edgeListDeepDag(&el, n, extra, seed++);
+                }
+                else {
+                    printf("Enter edge list file: ");
+                    scanf("%255s", path);
+                    ok = edgeListLoad(&el, path);
+                }
+                printf("Undirected (1/0): ");
+                scanf("%d", &undirected);
+                graphFree(&g);
+                free(out);
+                t = now();
+                ok = ok && graphBuild(&g, &el, undirected ? GRAPH_UNDIRECTED : 0);
+                out = ok ? (uint32_t*)malloc((g.n ? g.n : 1) * sizeof(uint32_t)) : NULL;
+                if (out == NULL) { printf("Could not build the graph"); graphFree(&g); edgeListFree(&el); break; }
+                printf("Built CSR graph: %u vertices, %llu edges in %.3f s", g.n, (unsigned long long)g.m, now() - t);
+                break;
+            case 4:
+                if (g.n == 0) { printf("No graph loaded"); break; }
+                printf("Enter start vertex: ");
+                scanf("%u", &source);
+                if (source >= g.n) { printf("Invalid vertex"); break; }
+                peakFrames = 0;
+                t = now();
+                reached = dfsPreorder(&g, source, out, g.n);
+                t = now() - t;
+                printf("DFS Traversal starting from vertex %u:", source);
+                for (i = 0; i < reached && i < 20; i++) printf(" %u", out[i]);
+                printf("%s\n%llu vertices reached in %.3f s, deepest stack %llu frames",
+                       reached > 20 ? " ..." : "", (unsigned long long)reached, t, (unsigned long long)peakFrames);
+                break;
+            case 5:
+            case 6:
+            case 7:
+                if (g.n == 0) { printf("No graph loaded"); break; }
+                peakFrames = 0;
+                t = now();
+                if (choice == 5) {
+                    count = stronglyConnected(&g, out);
+                    printf("%u strongly connected components in %.3f s, deepest stack %llu frames",
+                           count, now() - t, (unsigned long long)peakFrames);
+                }
+                else if (choice == 6) {
+                    ok = topologicalSort(&g, out);
+                    t = now() - t;
+                    if (!ok) { printf("Graph has a cycle (%.3f s)", t); break; }
+                    printf("Topological order:");
+                    for (u = 0; u < g.n && u < 20; u++) printf(" %u", out[u]);
+                    printf("%s\nSorted in %.3f s, deepest stack %llu frames", g.n > 20 ? " ..." : "", t, (unsigned long long)peakFrames);
+                }
+                else {
+                    if (undirected) {
+                        count = componentsDFS(&g, out);
+                        printf("DFS:        %u components in %.3f s\n", count, now() - t);
+                    }
+                    t = now();
+                    count = componentsUnionFind(&g, out);
+                    printf("Union-find: %u %scomponents in %.3f s with %d threads", count, undirected ? "" : "weakly connected ",
+                           now() - t, threads);
+                }
+                break;
+            case 8:
+                if (g.n == 0) { printf("No graph loaded"); break; }
+                printf("%s", verify(&g, &el, undirected) ? "All results agree" : "VERIFY FAILED");
+                break;
+            case 9:
+                printf("Enter number of threads: ");
+                scanf("%d", &threads);
+                if (threads < 1) threads = 1;
+                if (threads > MAX_THREADS) threads = MAX_THREADS;
+                break;
+            case 10: break;
+            default: printf("Invalid choice");
+        }
+    } while (choice != 10);
+    graphFree(&g);
+    edgeListFree(&el);
+    free(out);
+    return 0;
+}
@@ -0,0 +1,373 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+#include "csr_graph.h"
+
+// Multi-source BFS (MS-BFS, Then et al.): one traversal answers a whole
+// batch of 64 to 512 BFS queries on a CSR graph.
+//
+// Every vertex has three bitsets of batch bits, bit i standing for
+// source i: seen (reached by source i), visit (in source i's frontier
+// now) and next (in its next frontier). A level is then word-wide logic
+// on those bitsets:
+//   top-down:  for each v with visit[v] != 0, for each neighbour n:
+//                  d = visit[v] & ~seen[n]; next[n] |= d; seen[n] |= d
+//   bottom-up: for each v not yet seen by every source:
+//                  next[v] = OR of visit[n] over its in-neighbours, & ~seen[v]
+// so each edge is scanned once per level for the whole batch instead of
+// once per source. Bottom-up stops scanning a vertex as soon as every
+// source that has not reached it yet has been found; it is used when
+// the active vertices cover more than 1/ALPHA of the edges. Both forms
+// keep the sources in lockstep: bit i is set in next[] exactly when the
+// single-source BFS from source i would reach that vertex at this level.
+//
+// A batch uses 3 * V * batch/8 bytes. Larger query sets are split into
+// batches that worker threads take in turn, each with its own bitsets.
+// Results per source are the distance to every vertex (optional, 4V
+// bytes per source), the number of vertices reached and the sum of
+// distances; reachability is the seen bitset itself.
+//
+// Uses pthreads and mmap (POSIX), so this program does not include
+// conio.h.
+
+#define MAX_WORDS 8          // 512 sources per batch
+#define MAX_THREADS 64
+#define ALPHA 20
+
+struct MSBFS {
+    const struct Graph *out, *in;   // in == out for undirected graphs
+    int words;                      // words per vertex bitset
+    uint64_t *seen, *visit, *next;  // n * words each
+};
+
+struct Batch {                      // per-source results
+    uint64_t reached[MAX_WORDS * 64];
+    uint64_t distSum[MAX_WORDS * 64];
+};
+
+int threads = 4;
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int initMSBFS(struct MSBFS *ms, const struct Graph *out, const struct Graph *in, int words) {
+    uint64_t cells = (uint64_t)out->n * words + 1;
+    ms->out = out;
+    ms->in = in;
+    ms->words = words;
+    ms->seen = (uint64_t*)calloc(cells, sizeof(uint64_t));
+    ms->visit = (uint64_t*)calloc(cells, sizeof(uint64_t));
+    ms->next = (uint64_t*)calloc(cells, sizeof(uint64_t));
+    return ms->seen && ms->visit && ms->next;
+}
+
+void freeMSBFS(struct MSBFS *ms) {
+    free(ms->seen);
+    free(ms->visit);
+    free(ms->next);
+}
+
+// ---------- Levels ----------
+
+void topDownLevel(struct MSBFS *ms) {
+    const struct Graph *g = ms->out;
+    const int W = ms->words;
+    uint64_t *seen = ms->seen, *visit = ms->visit, *next = ms->next, e, any, d;
+    uint32_t v, n;
+    int k;
+    for (v = 0; v < g->n; v++) {
+        const uint64_t *vv = visit + (uint64_t)v * W;
+        for (any = 0, k = 0; k < W; k++) any |= vv[k];
+        if (!any) continue;
+        for (e = g->offsets[v]; e < g->offsets[v + 1]; e++) {
+            n = g->adj[e];
+            for (k = 0; k < W; k++) {
+                d = vv[k] & ~seen[(uint64_t)n * W + k];
+                next[(uint64_t)n * W + k] |= d;
+                seen[(uint64_t)n * W + k] |= d;
+            }
+        }
+    }
+}
+
+void bottomUpLevel(struct MSBFS *ms, const uint64_t *full) {
+    const struct Graph *g = ms->in;
+    const int W = ms->words;
+    uint64_t *seen = ms->seen, *visit = ms->visit, *next = ms->next, e, missing, found;
+    uint64_t want[MAX_WORDS], acc[MAX_WORDS];
+    uint32_t v, n;
+    int k;
+    for (v = 0; v < g->n; v++) {
+        uint64_t *sv = seen + (uint64_t)v * W;
+        for (missing = 0, k = 0; k < W; k++) { want[k] = full[k] & ~sv[k]; acc[k] = 0; missing |= want[k]; }
+        if (!missing) continue;
+        for (e = g->offsets[v]; e < g->offsets[v + 1]; e++) {
+            n = g->adj[e];
+            for (missing = 0, k = 0; k < W; k++) {
+                acc[k] |= visit[(uint64_t)n * W + k];
+                missing |= want[k] & ~acc[k];
+            }
+            if (!missing) break;   // every source still looking has found v
+        }
+        for (found = 0, k = 0; k < W; k++) {
+            next[(uint64_t)v * W + k] = acc[k] & want[k];
+            found |= acc[k] & want[k];
+        }
+        if (found)
+            for (k = 0; k < W; k++) sv[k] |= next[(uint64_t)v * W + k];
+    }
+}
+
+// BFS from sources[0..count-1] at once (count <= 64 * words). Fills the
+// per-source results in b and, if dist is not NULL, dist[i * n + v] =
+// distance from source i to v or -1. ms->seen holds the reachability
+// bitsets afterwards. Returns the number of levels.
+int msbfs(struct MSBFS *ms, const uint32_t *sources, int count, struct Batch *b, int32_t *dist) {
+    const struct Graph *g = ms->out;
+    const int W = ms->words;
+    uint64_t cells = (uint64_t)g->n * W, full[MAX_WORDS] = { 0 }, frontierEdges, bits, *t, c;
+    uint32_t v;
+    int i, k, level = 0, bottomUp;
+    memset(ms->seen, 0, cells * sizeof(uint64_t));
+    memset(ms->visit, 0, cells * sizeof(uint64_t));
+    memset(ms->next, 0, cells * sizeof(uint64_t));
+    if (dist) for (c = 0; c < (uint64_t)count * g->n; c++) dist[c] = -1;
+    frontierEdges = 0;
+    for (i = 0; i < count; i++) {
+        full[i / 64] |= 1ULL << (i % 64);
+        ms->seen[(uint64_t)sources[i] * W + i / 64] |= 1ULL << (i % 64);
+        ms->visit[(uint64_t)sources[i] * W + i / 64] |= 1ULL << (i % 64);
+        b->reached[i] = 1;
+        b->distSum[i] = 0;
+        if (dist) dist[(uint64_t)i * g->n + sources[i]] = 0;
+        frontierEdges += graphDegree(g, sources[i]);
+    }
+    for (;;) {
+        bottomUp = frontierEdges > g->m / ALPHA;
+        if (bottomUp) bottomUpLevel(ms, full);
+        else topDownLevel(ms);
+        level++;
+        // Record the new frontier, and count its edges for the next choice
+        frontierEdges = 0;
+        c = 0;
+        for (v = 0; v < g->n; v++) {
+            uint64_t *nv = ms->next + (uint64_t)v * W, any = 0;
+            for (k = 0; k < W; k++) {
+                for (bits = nv[k]; bits; bits &= bits - 1) {
+                    i = k * 64 + __builtin_ctzll(bits);
+                    b->reached[i]++;
+                    b->distSum[i] += level;
+                    if (dist) dist[(uint64_t)i * g->n + v] = level;
+                }
+                any |= nv[k];
+            }
+            if (any) { c++; frontierEdges += graphDegree(g, v); }
+        }
+        if (c == 0) break;
+        t = ms->visit; ms->visit = ms->next; ms->next = t;
+        memset(ms->next, 0, cells * sizeof(uint64_t));
+    }
+    return level - 1;
+}
+
+// ---------- One source at a time, for comparison ----------
+
+// Plain queue BFS over the CSR graph; dist must hold n entries
+void singleBFS(const struct Graph *g, uint32_t source, int32_t *dist, uint32_t *queue,
+               uint64_t *reached, uint64_t *distSum) {
+    uint64_t front = 0, rear = 0, e;
+    uint32_t u, v;
+    for (v = 0; v < g->n; v++) dist[v] = -1;
+    dist[source] = 0;
+    queue[rear++] = source;
+    *distSum = 0;
+    while (front < rear) {
+        u = queue[front++];
+        *distSum += dist[u];
+        for (e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            v = g->adj[e];
+            if (dist[v] < 0) { dist[v] = dist[u] + 1; queue[rear++] = v; }
+        }
+    }
+    *reached = rear;
+}
+
+// ---------- Many queries on several threads ----------
+
+struct Job {
+    const struct Graph *out, *in;
+    const uint32_t *sources;
+    int count, batch, single;       // single: one BFS per source instead
+    uint64_t *reached, *distSum;    // results for all sources
+    _Atomic int cursor;
+    _Atomic int failed;
+};
+
+void *queryWorker(void *arg) {
+    struct Job *j = (struct Job*)arg;
+    struct MSBFS ms = { 0 };
+    struct Batch *b = NULL;
+    int32_t *dist = NULL;
+    uint32_t *queue = NULL;
+    int lo, hi, i, ok;
+    if (j->single) {
+        dist = (int32_t*)malloc((j->out->n ? j->out->n : 1) * sizeof(int32_t));
+        queue = (uint32_t*)malloc((j->out->n ? j->out->n : 1) * sizeof(uint32_t));
+        ok = dist && queue;
+    }
+    else {
+        b = (struct Batch*)malloc(sizeof(struct Batch));
+        ok = b && initMSBFS(&ms, j->out, j->in, j->batch / 64);
+    }
+    while (ok && (lo = atomic_fetch_add(&j->cursor, j->batch)) < j->count) {
+        hi = lo + j->batch < j->count ? lo + j->batch : j->count;
+        if (j->single)
+            for (i = lo; i < hi; i++) singleBFS(j->out, j->sources[i], dist, queue, &j->reached[i], &j->distSum[i]);
+        else {
+            msbfs(&ms, j->sources + lo, hi - lo, b, NULL);
+            memcpy(j->reached + lo, b->reached, (hi - lo) * sizeof(uint64_t));
+            memcpy(j->distSum + lo, b->distSum, (hi - lo) * sizeof(uint64_t));
+        }
+    }
+    if (!ok) atomic_store(&j->failed, 1);
+    if (!j->single) freeMSBFS(&ms);
+    free(b); free(dist); free(queue);
+    return NULL;
+}
+
+int runQueries(struct Job *j) {
+    pthread_t th[MAX_THREADS];
+    int k;
+    atomic_store(&j->cursor, 0);
+    atomic_store(&j->failed, 0);
+    for (k = 1; k < threads; k++) pthread_create(&th[k], NULL, queryWorker, j);
+    queryWorker(j);
+    for (k = 1; k < threads; k++) pthread_join(th[k], NULL);
+    return !atomic_load(&j->failed);
+}
+
+int main() {
+    struct EdgeList el;
+    struct Graph out = { 0 }, in = { 0 };
+    struct MSBFS ms;
+    struct Batch *b = (struct Batch*)malloc(sizeof(struct Batch));
+    struct Job job;
+    uint32_t *sources = NULL, *s;
+    uint64_t *reached2 = NULL, *distSum2 = NULL, *r, seed = 1;
+    int32_t *dist;
+    int choice, scale, factor, undirected = 1, count, batch = 256, i, ok, levels, mismatch;
+    unsigned target;
+    char path[256];
+    double t, tm, ts;
+    if (b == NULL) { printf("Out of memory\n"); return 1; }
+    do {
+        printf("\n1.Generate R-MAT Graph 2.Load Edge List 3.Benchmark Queries 4.Distances To Target 5.Set Batch Size 6.Set Threads 7.Exit\nEnter choice: ");
+        if (scanf("%d", &choice) != 1) break;
+        switch (choice) {
+            case 1:
+            case 2:
+                if (choice == 1) {
+                    printf("Enter scale (log2 vertices) and edge factor: ");
+                    scanf("%d %d", &scale, &factor);
+                    ok = edgeListRmat(&el, scale, factor, seed++);
+                }
+                else {
+                    printf("Enter edge list file: ");
+                    scanf("%255s", path);
+                    ok = edgeListLoad(&el, path);
+                }
+                printf("Undirected (1/0): ");
+                scanf("%d", &undirected);
+                if (in.adj != out.adj) graphFree(&in);
+                graphFree(&out);
+                in = out;
+                t = now();
+                ok = ok && graphBuild(&out, &el, undirected ? GRAPH_UNDIRECTED : 0);
+                if (ok && !undirected) ok = graphBuild(&in, &el, GRAPH_TRANSPOSE);
+                else if (ok) in = out;
+                edgeListFree(&el);
+                if (!ok) { printf("Could not build the graph"); graphFree(&out); in = out; break; }
+                printf("Built CSR graph: %u vertices, %llu edges in %.3f s", out.n, (unsigned long long)out.m, now() - t);
+                break;
+            case 3:
+                if (out.n == 0) { printf("No graph loaded"); break; }
+                printf("Enter number of random sources: ");
+                scanf("%d", &count);
+                if (count < 1) { printf("Invalid input"); break; }
+                // two result slots per source: MS-BFS, then one BFS per source
+                if ((s = (uint32_t*)realloc(sources, (size_t)count * sizeof(uint32_t))) == NULL) { printf("Out of memory"); break; }
+                sources = s;
+                if ((r = (uint64_t*)realloc(reached2, 2 * (size_t)count * sizeof(uint64_t))) == NULL) { printf("Out of memory"); break; }
+                reached2 = r;
+                if ((r = (uint64_t*)realloc(distSum2, 2 * (size_t)count * sizeof(uint64_t))) == NULL) { printf("Out of memory"); break; }
+                distSum2 = r;
+                for (i = 0; i < count; i++) sources[i] = (uint32_t)(graphRandom(&seed) % out.n);
+                job.out = &out; job.in = &in; job.sources = sources; job.count = count; job.batch = batch;
+
+                job.single = 0; job.reached = reached2; job.distSum = distSum2;
+                t = now();
+                ok = runQueries(&job);
+                tm = now() - t;
+                job.single = 1; job.reached = reached2 + count; job.distSum = distSum2 + count;
+                t = now();
+                ok = ok && runQueries(&job);
+                ts = now() - t;
+                if (!ok) { printf("Out of memory"); break; }
+                for (i = 0, mismatch = 0; i < count; i++)
+                    mismatch += reached2[i] != reached2[count + i] || distSum2[i] != distSum2[count + i];
+                printf("MS-BFS (%d per batch): %.3f s, %.0f queries/s\n", batch, tm, count / tm);
+                printf("One BFS per source:     %.3f s, %.0f queries/s\n", ts, count / ts);
+                printf("Speedup %.1fx, %s", ts / tm, mismatch ? "RESULTS DIFFER" : "all sources agree");
+                break;
+            case 4:
+                if (out.n == 0) { printf("No graph loaded"); break; }
+                printf("Enter number of sources (1-%d): ", MAX_WORDS * 64);
+                scanf("%d", &count);
+                if (count < 1 || count > MAX_WORDS * 64) { printf("Invalid input"); break; }
+                if ((s = (uint32_t*)realloc(sources, (size_t)count * sizeof(uint32_t))) == NULL) { printf("Out of memory"); break; }
+                sources = s;
+                printf("Enter sources: ");
+                for (i = 0, ok = 1; i < count; i++) { scanf("%u", &sources[i]); ok = ok && sources[i] < out.n; }
+                printf("Enter target vertex: ");
+                scanf("%u", &target);
+                if (!ok || target >= out.n) { printf("Invalid vertex"); break; }
+                dist = (int32_t*)malloc((uint64_t)count * out.n * sizeof(int32_t));
+                if (dist == NULL || !initMSBFS(&ms, &out, &in, (count + 63) / 64)) { printf("Out of memory"); free(dist); break; }
+                levels = msbfs(&ms, sources, count, b, dist);
+                printf("%d levels\n", levels);
+                for (i = 0; i < count; i++) {
+                    if (dist[(uint64_t)i * out.n + target] < 0) printf("%u -> %u: unreachable\n", sources[i], target);
+                    else printf("%u -> %u: %d (%llu vertices reached)\n", sources[i], target, dist[(uint64_t)i * out.n + target],
+                                (unsigned long long)b->reached[i]);
+                }
+                freeMSBFS(&ms);
+                free(dist);
+                break;
+            case 5:
+                printf("Enter batch size (64, 128, 256 or 512): ");
+                scanf("%d", &batch);
+                if (batch < 64) batch = 64;
+                if (batch > MAX_WORDS * 64) batch = MAX_WORDS * 64;
+                batch -= batch % 64;
+                break;
+            case 6:
+                printf("Enter number of threads: ");
+                scanf("%d", &threads);
+                if (threads < 1) threads = 1;
+                if (threads > MAX_THREADS) threads = MAX_THREADS;
+                break;
+            case 7: break;
+            default: printf("Invalid choice");
+        }
+    } while (choice != 7);
+    if (in.adj != out.adj) graphFree(&in);
+    graphFree(&out);
+    free(sources); free(reached2); free(distSum2); free(b);
+    return 0;
+}
@@ -0,0 +1,312 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "csr_graph.h"
+
+// Vertex reordering for cache locality. Traversals read the neighbours'
+// entries (visited flags, distances, values) at the neighbours' ids, so
+// when ids are arbitrary almost every access is a cache miss. Giving
+// vertices that are close in the graph nearby ids turns many of those
+// misses into hits without changing what the traversal computes.
+//
+// Orderings, each a permutation newId[old] = new:
+//   - Reverse Cuthill-McKee: BFS from a pseudo-peripheral vertex of each
+//     component, adding each vertex's unvisited neighbours in increasing
+//     degree order, then reversing the whole order. Keeps neighbour ids
+//     close to each other (small bandwidth).
+//   - Degree sort: highest degree first, so the hubs that most edges point
+//     to share a few cache lines.
+//   - BFS order: plain BFS from the highest-degree vertex of each
+//     component.
+//
+// The graph is rewritten with graphRelabel(). Locality is reported as the
+// average gap |id(u) - id(v)| over all edges, the average log2 of that
+// gap (about the bits a gap-encoded list needs per edge) and the largest
+// gap (bandwidth).
+//
+// The orderings and traversals return 0 if their work buffers cannot be
+// allocated. Uses mmap through csr_graph.h (POSIX), so this program does
+// not include conio.h.
+
+#define REPEAT 5             // timing runs per traversal
+#define PLACED INT32_MAX     // level[] of a vertex already in the RCM order
+
+enum { ORDER_RCM = 1, ORDER_DEGREE, ORDER_BFS };
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// ---------- Orderings ----------
+
+const struct Graph *sortGraph;   // for the qsort comparison below
+
+int byDegree(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    uint64_t dx = graphDegree(sortGraph, x), dy = graphDegree(sortGraph, y);
+    if (dx != dy) return dx < dy ? -1 : 1;
+    return x < y ? -1 : x > y;
+}
+
+// BFS from s over unvisited vertices; returns the vertices reached in
+// queue[0..count-1] and their levels in level[]. Vertices with level >= 0
+// are skipped, so a directed search stops at vertices already placed.
+uint64_t bfsLevels(const struct Graph *g, uint32_t s, int32_t *level, uint32_t *queue) {
+    uint64_t front = 0, rear = 0, e;
+    uint32_t u, v;
+    level[s] = 0;
+    queue[rear++] = s;
+    while (front < rear) {
+        u = queue[front++];
+        for (e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            v = g->adj[e];
+            if (level[v] < 0) { level[v] = level[u] + 1; queue[rear++] = v; }
+        }
+    }
+    return rear;
+}
+
+// George-Liu heuristic: BFS, move to a lowest-degree vertex of the last
+// level, repeat while the number of levels keeps growing. level[] of the
+// vertices reached is reset to -1 each round.
+uint32_t pseudoPeripheral(const struct Graph *g, uint32_t s, int32_t *level, uint32_t *queue) {
+    uint64_t count, i;
+    int32_t depth = -1, ecc;
+    uint32_t best;
+    int rounds;
+    for (rounds = 0; rounds < 8; rounds++) {
+        count = bfsLevels(g, s, level, queue);
+        ecc = level[queue[count - 1]];
+        best = queue[count - 1];
+        for (i = count; i-- > 0 && level[queue[i]] == ecc;)
+            if (graphDegree(g, queue[i]) < graphDegree(g, best)) best = queue[i];
+        for (i = 0; i < count; i++) level[queue[i]] = -1;
+        if (ecc <= depth) break;
+        depth = ecc;
+        s = best;
+    }
+    return s;
+}
+
+int orderRCM(const struct Graph *g, uint32_t *newId) {
+    int32_t *level = (int32_t*)malloc((g->n ? g->n : 1) * sizeof(int32_t));
+    uint32_t *queue = (uint32_t*)malloc((g->n ? g->n : 1) * sizeof(uint32_t));
+    uint32_t *order = (uint32_t*)malloc((g->n ? g->n : 1) * sizeof(uint32_t));
+    uint64_t pos = 0, head, e, start;
+    uint32_t r, s, u, v;
+    if (level == NULL || queue == NULL || order == NULL) { free(level); free(queue); free(order); return 0; }
+    for (r = 0; r < g->n; r++) level[r] = -1;
+    sortGraph = g;
+    for (r = 0; r < g->n;) {
+        if (level[r] >= 0) { r++; continue; }   // a directed search from s may miss r
+        s = pseudoPeripheral(g, r, level, queue);
+        level[s] = PLACED;
+        order[pos++] = s;
+        for (head = pos - 1; head < pos; head++) {
+            u = order[head];
+            start = pos;
+            for (e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+                v = g->adj[e];
+                if (level[v] >= 0) continue;
+                level[v] = PLACED;
+                order[pos++] = v;
+            }
+            if (pos - start > 1) qsort(order + start, pos - start, sizeof(uint32_t), byDegree);
+        }
+    }
+    for (pos = 0; pos < g->n; pos++) newId[order[pos]] = (uint32_t)(g->n - 1 - pos);
+    free(level); free(queue); free(order);
+    return 1;
+}
+
+// Counting sort on degree, highest first, ties by old id
+int orderByDegree(const struct Graph *g, uint32_t *newId) {
+    uint64_t maxDeg = 0, d, *start;
+    uint32_t u;
+    for (u = 0; u < g->n; u++) if (graphDegree(g, u) > maxDeg) maxDeg = graphDegree(g, u);
+    start = (uint64_t*)calloc(maxDeg + 2, sizeof(uint64_t));
+    if (start == NULL) return 0;
+    for (u = 0; u < g->n; u++) start[maxDeg - graphDegree(g, u) + 1]++;
+    for (d = 0; d <= maxDeg; d++) start[d + 1] += start[d];
+    for (u = 0; u < g->n; u++) newId[u] = (uint32_t)start[maxDeg - graphDegree(g, u)]++;
+    free(start);
+    return 1;
+}
+
+// BFS from the highest-degree unvisited vertex, component by component
+int orderByBFS(const struct Graph *g, uint32_t *newId) {
+    int32_t *level = (int32_t*)malloc((g->n ? g->n : 1) * sizeof(int32_t));
+    uint32_t *byDeg = (uint32_t*)malloc((g->n ? g->n : 1) * sizeof(uint32_t));
+    uint32_t *queue = (uint32_t*)malloc((g->n ? g->n : 1) * sizeof(uint32_t));
+    uint64_t pos = 0, count, i;
+    uint32_t r, s;
+    if (level == NULL || byDeg == NULL || queue == NULL || !orderByDegree(g, newId)) {
+        free(level); free(byDeg); free(queue);
+        return 0;
+    }
+    for (r = 0; r < g->n; r++) { byDeg[newId[r]] = r; level[r] = -1; }
+    for (r = 0; r < g->n; r++) {
+        s = byDeg[r];
+        if (level[s] >= 0) continue;
+        count = bfsLevels(g, s, level, queue);
+        for (i = 0; i < count; i++) newId[queue[i]] = (uint32_t)pos++;
+    }
+    free(level); free(byDeg); free(queue);
+    return 1;
+}
+
+// ---------- Measuring ----------
+
+void locality(const struct Graph *g, const char *name) {
+    uint64_t u, e, gap, maxGap = 0;
+    double sum = 0, bits = 0;
+    for (u = 0; u < g->n; u++)
+        for (e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            gap = g->adj[e] > u ? g->adj[e] - u : u - g->adj[e];
+            sum += gap;
+            bits += log2((double)gap + 1);
+            if (gap > maxGap) maxGap = gap;
+        }
+    printf("%-10s average gap %12.1f  average log2 gap %5.2f  bandwidth %u\n", name,
+           g->m ? sum / g->m : 0.0, g->m ? bits / g->m : 0.0, (unsigned)maxGap);
+}
+
+// Time a serial BFS and a neighbour-sum sweep (y[u] = sum of x[v]); both
+// read per-vertex data at the neighbours' ids. dist gets the BFS result.
+int traversals(const struct Graph *g, uint32_t source, int32_t *dist, double *bfsTime, double *sweepTime,
+               double *checksum) {
+    uint32_t *queue = (uint32_t*)malloc((g->n ? g->n : 1) * sizeof(uint32_t)), u;
+    double *x = (double*)malloc((g->n ? g->n : 1) * sizeof(double)), y, t;
+    uint64_t e;
+    int r;
+    if (queue == NULL || x == NULL) { free(queue); free(x); return 0; }
+    for (u = 0; u < g->n; u++) x[u] = 1.0 / (1 + graphDegree(g, u));
+    *bfsTime = *sweepTime = 1e30;
+    for (r = 0; r < REPEAT; r++) {
+        for (u = 0; u < g->n; u++) dist[u] = -1;
+        t = now();
+        bfsLevels(g, source, dist, queue);
+        t = now() - t;
+        if (t < *bfsTime) *bfsTime = t;
+        t = now();
+        for (*checksum = 0, u = 0; u < g->n; u++) {
+            for (y = 0, e = g->offsets[u]; e < g->offsets[u + 1]; e++) y += x[g->adj[e]];
+            *checksum += y;
+        }
+        t = now() - t;
+        if (t < *sweepTime) *sweepTime = t;
+    }
+    free(queue);
+    free(x);
+    return 1;
+}
+
+int saveReordered(const struct Graph *h, const uint32_t *newId, uint32_t n, const char *edgePath, const char *mapPath) {
+    FILE *fe = fopen(edgePath, "w"), *fm = fopen(mapPath, "w");
+    uint64_t e;
+    uint32_t u;
+    int ok = fe && fm;
+    if (ok) {
+        fprintf(fe, "# relabeled graph: %u vertices, %llu edges\n", h->n, (unsigned long long)h->m);
+        for (u = 0; u < h->n; u++)
+            for (e = h->offsets[u]; e < h->offsets[u + 1]; e++) fprintf(fe, "%u %u\n", u, h->adj[e]);
+        fprintf(fm, "# old new\n");
+        for (u = 0; u < n; u++) fprintf(fm, "%u %u\n", u, newId[u]);
+        ok = !ferror(fe) && !ferror(fm);
+    }
+    if (fe && fclose(fe) != 0) ok = 0;
+    if (fm && fclose(fm) != 0) ok = 0;
+    return ok;
+}
+
+int main() {
+    static const char *orderName[] = { "", "RCM", "Degree", "BFS" };
+    struct EdgeList el;
+    struct Graph g = { 0 }, h = { 0 };
+    uint32_t *newId = NULL, source = 0, u;
+    int32_t *d1 = NULL, *d2 = NULL;
+    uint64_t seed = 1, mismatch;
+    int choice, scale, factor, undirected = 1, method, ok;
+    char path[256], mapPath[256];
+    double t, b1, s1, c1, b2, s2, c2;
+    do {
+        printf("\n1.Generate R-MAT Graph 2.Load Edge List 3.Locality Report 4.Reorder 5.Save Reordered Graph 6.Exit\nEnter choice: ");
+        if (scanf("%d", &choice) != 1) break;
+        switch (choice) {
+            case 1:
+            case 2:
+                if (choice == 1) {
+                    printf("Enter scale (log2 vertices) and edge factor: ");
+                    scanf("%d %d", &scale, &factor);
+                    ok = edgeListRmat(&el, scale, factor, seed++);
+                }
+                else {
+                    printf("Enter edge list file: ");
+                    scanf("%255s", path);
+                    ok = edgeListLoad(&el, path);
+                }
+                printf("Undirected (1/0): ");
+                scanf("%d", &undirected);
+                graphFree(&g);
+                graphFree(&h);
+                free(newId); free(d1); free(d2);
+                newId = NULL; d1 = d2 = NULL;
+                t = now();
+                ok = ok && graphBuild(&g, &el, undirected ? GRAPH_UNDIRECTED : 0);
+                edgeListFree(&el);
+                if (ok) {
+                    newId = (uint32_t*)malloc((g.n ? g.n : 1) * sizeof(uint32_t));
+                    d1 = (int32_t*)malloc((g.n ? g.n : 1) * sizeof(int32_t));
+                    d2 = (int32_t*)malloc((g.n ? g.n : 1) * sizeof(int32_t));
+                }
+                if (!ok || !newId || !d1 || !d2) { printf("Could not build the graph"); graphFree(&g); break; }
+                for (source = 0, u = 0; u < g.n; u++) if (graphDegree(&g, u) > graphDegree(&g, source)) source = u;
+                printf("Built CSR graph: %u vertices, %llu edges in %.3f s", g.n, (unsigned long long)g.m, now() - t);
+                break;
+            case 3:
+                if (g.n == 0) { printf("No graph loaded"); break; }
+                locality(&g, "Original:");
+                if (h.n) locality(&h, "Reordered:");
+                break;
+            case 4:
+                if (g.n == 0) { printf("No graph loaded"); break; }
+                printf("Enter method (1 Reverse Cuthill-McKee, 2 Degree sort, 3 BFS order): ");
+                scanf("%d", &method);
+                if (method < ORDER_RCM || method > ORDER_BFS) { printf("Invalid method"); break; }
+                graphFree(&h);
+                t = now();
+                if (method == ORDER_RCM) ok = orderRCM(&g, newId);
+                else if (method == ORDER_DEGREE) ok = orderByDegree(&g, newId);
+                else ok = orderByBFS(&g, newId);
+                if (!ok || !graphRelabel(&h, &g, newId)) { printf("Out of memory"); break; }
+                printf("%s ordering and relabel: %.3f s\n", orderName[method], now() - t);
+                locality(&g, "Original:");
+                locality(&h, "Reordered:");
+                if (!traversals(&g, source, d1, &b1, &s1, &c1) || !traversals(&h, newId[source], d2, &b2, &s2, &c2)) {
+                    printf("Out of memory");
+                    break;
+                }
+                for (mismatch = 0, u = 0; u < g.n; u++) mismatch += d1[u] != d2[newId[u]];
+                printf("BFS:             %8.3f ms -> %8.3f ms (%.2fx)\n", b1 * 1e3, b2 * 1e3, b1 / b2);
+                printf("Neighbour sweep: %8.3f ms -> %8.3f ms (%.2fx)\n", s1 * 1e3, s2 * 1e3, s1 / s2);
+                printf("%s", mismatch == 0 && fabs(c1 - c2) <= 1e-9 * fabs(c1) ? "Results unchanged" : "RESULTS DIFFER");
+                break;
+            case 5:
+                if (h.n == 0) { printf("Reorder the graph first"); break; }
+                printf("Enter output edge list file and mapping file: ");
+                scanf("%255s %255s", path, mapPath);
+                printf("%s", saveReordered(&h, newId, g.n, path, mapPath) ? "Saved" : "Could not write the files");
+                break;
+            case 6: break;
+            default: printf("Invalid choice");
+        }
+    } while (choice != 6);
+    graphFree(&g);
+    graphFree(&h);
+    free(newId); free(d1); free(d2);
+    return 0;
+}
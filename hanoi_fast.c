@@ -0,0 +1,271 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+
+// Tower of Hanoi without recursion.
+//
+// Number the moves m = 1 .. 2^n - 1. Move m moves disk ctz(m) + 1 (the
+// lowest set bit, as in a binary counter), from peg (m & (m-1)) % 3 to
+// peg ((m | (m-1)) + 1) % 3. Those pegs are for a tower that ends on peg
+// C when n is odd and on peg B when n is even, so for even n B and C are
+// swapped. Every move is therefore computed on its own in O(1), which
+// gives:
+//   - a generator that fills a caller-supplied buffer with any range of
+//     moves, in batches, with no allocation or recursion
+//   - kthMove() without replaying the earlier moves
+//   - configuration(), the peg of every disk after k moves, in O(n)
+//   - a parallel mode where each thread takes a slice of the move range
+// and printing goes through one large buffer instead of a printf per move.
+
+#define MAX_DISKS 63
+#define BATCH 4096
+#define MAX_THREADS 64
+
+struct Move {
+    unsigned char disk, from, to;   // pegs 0, 1, 2 = A, B, C
+};
+
+// Move number k (0-based) of an n-disk tower from A to C
+struct Move kthMove(int n, uint64_t k) {
+    static const unsigned char swapBC[3] = { 0, 2, 1 };
+    struct Move mv;
+    uint64_t m = k + 1;
+    mv.disk = (unsigned char)(__builtin_ctzll(m) + 1);
+    mv.from = (unsigned char)((m & (m - 1)) % 3);
+    mv.to = (unsigned char)(((m | (m - 1)) + 1) % 3);
+    if (n % 2 == 0) { mv.from = swapBC[mv.from]; mv.to = swapBC[mv.to]; }
+    return mv;
+}
+
+// peg[d] = peg of disk d (1..n) after the first k moves
+void configuration(int n, uint64_t k, unsigned char *peg) {
+    int src = 0, aux = 1, dst = 2, t, d;
+    for (d = n; d >= 1; d--) {
+        uint64_t half = 1ULL << (d - 1);   // moves needed for the d-1 disks above
+        if (k < half) {                    // still moving them out of the way
+            peg[d] = (unsigned char)src;
+            t = aux; aux = dst; dst = t;
+        }
+        else {                             // disk d is on dst, rest heading there
+            peg[d] = (unsigned char)dst;
+            k -= half;
+            t = src; src = aux; aux = t;
+        }
+    }
+}
+
+// Fill buf with moves first .. first+count-1. Disk d always steps the
+// same way round the pegs (A->C->B->A if n-d is even, else A->B->C->A), so
+// after finding every disk's peg once, each move is a table lookup.
+void generateMoves(int n, uint64_t first, struct Move *buf, int count) {
+    static const unsigned char next[2][3] = { { 2, 0, 1 }, { 1, 2, 0 } };
+    unsigned char peg[MAX_DISKS + 2];
+    uint64_t m = first + 1;
+    int i, d;
+    configuration(n, first, peg);
+    for (i = 0; i < count; i++, m++) {
+        d = __builtin_ctzll(m) + 1;
+        buf[i].disk = (unsigned char)d;
+        buf[i].from = peg[d];
+        buf[i].to = peg[d] = next[(n - d) & 1][peg[d]];
+    }
+}
+
+// ---------- Buffered output ----------
+
+char outBuf[1 << 16];
+int outLen;
+
+void flushOut() {
+    fwrite(outBuf, 1, outLen, stdout);
+    outLen = 0;
+}
+
+void printMoves(int n) {
+    static const char pegName[] = "ABC";
+    static const char text[] = "Move disk ";
+    struct Move buf[BATCH];
+    uint64_t total = (1ULL << n) - 1, k;
+    int count, i, j, len;
+    char digits[4];
+    for (k = 0; k < total; k += count) {
+        count = total - k < BATCH ? (int)(total - k) : BATCH;
+        generateMoves(n, k, buf, count);
+        for (i = 0; i < count; i++) {
+            if (outLen > (int)sizeof(outBuf) - 32) flushOut();
+            for (j = 0; j < 10; j++) outBuf[outLen++] = text[j];
+            for (len = 0, j = buf[i].disk; j; j /= 10) digits[len++] = (char)('0' + j % 10);
+            while (len) outBuf[outLen++] = digits[--len];
+            outBuf[outLen++] = ' '; outBuf[outLen++] = 'f'; outBuf[outLen++] = 'r'; outBuf[outLen++] = 'o';
+            outBuf[outLen++] = 'm'; outBuf[outLen++] = ' ';
+            outBuf[outLen++] = pegName[buf[i].from];
+            outBuf[outLen++] = ' '; outBuf[outLen++] = 't'; outBuf[outLen++] = 'o'; outBuf[outLen++] = ' ';
+            outBuf[outLen++] = pegName[buf[i].to];
+            outBuf[outLen++] = '\n';
+        }
+    }
+    flushOut();
+}
+
+// ---------- Parallel generation ----------
+
+struct Slice {
+    int n;
+    uint64_t first, last;   // moves [first, last)
+    uint64_t checksum;
+};
+
+uint64_t checksum(struct Move *buf, int count) {   // order-independent
+    uint64_t s = 0;
+    int i;
+    for (i = 0; i < count; i++) s += buf[i].disk * 9 + buf[i].from * 3 + buf[i].to;
+    return s;
+}
+
+void *sliceWorker(void *arg) {
+    struct Slice *s = (struct Slice*)arg;
+    struct Move buf[BATCH];
+    uint64_t k;
+    int count;
+    s->checksum = 0;
+    for (k = s->first; k < s->last; k += count) {
+        count = s->last - k < BATCH ? (int)(s->last - k) : BATCH;
+        generateMoves(s->n, k, buf, count);
+        s->checksum += checksum(buf, count);
+    }
+    return NULL;
+}
+
+uint64_t runParallel(int n, int threads) {
+    pthread_t th[MAX_THREADS];
+    struct Slice s[MAX_THREADS];
+    uint64_t total = (1ULL << n) - 1, sum = 0;
+    int i;
+    for (i = 0; i < threads; i++) {
+        s[i].n = n;
+        s[i].first = total / threads * i;
+        s[i].last = i == threads - 1 ? total : total / threads * (i + 1);
+        pthread_create(&th[i], NULL, sliceWorker, &s[i]);
+    }
+    for (i = 0; i < threads; i++) { pthread_join(th[i], NULL); sum += s[i].checksum; }
+    return sum;
+}
+
+// Same checksum from the recursive algorithm, for comparison
+uint64_t recSum;
+void hanoiRec(int n, int source, int aux, int dest) {
+    if (n == 0) return;
+    hanoiRec(n - 1, source, dest, aux);
+    recSum += n * 9 + source * 3 + dest;
+    hanoiRec(n - 1, aux, source, dest);
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Replay all moves on three stacks and check each one is legal, and that
+// the batch generator, kthMove() and configuration() agree with the replay
+int verify(int n) {
+    int pegs[3][MAX_DISKS + 1], top[3] = { 0, 0, 0 }, d, ok = 1;
+    unsigned char peg[MAX_DISKS + 1];
+    struct Move buf[BATCH], mv;
+    uint64_t k, total = (1ULL << n) - 1;
+    for (d = n; d >= 1; d--) pegs[0][top[0]++] = d;
+    for (k = 0; k < total && ok; k++) {
+        if (k % BATCH == 0) generateMoves(n, k, buf, total - k < BATCH ? (int)(total - k) : BATCH);
+        mv = kthMove(n, k);
+        if (mv.disk != buf[k % BATCH].disk || mv.from != buf[k % BATCH].from || mv.to != buf[k % BATCH].to) ok = 0;
+        if (top[mv.from] == 0 || pegs[mv.from][top[mv.from] - 1] != mv.disk) ok = 0;
+        else if (top[mv.to] > 0 && pegs[mv.to][top[mv.to] - 1] < mv.disk) ok = 0;
+        else pegs[mv.to][top[mv.to]++] = pegs[mv.from][--top[mv.from]];
+        if (ok && (k & 1023) == 0) {   // spot-check configuration()
+            configuration(n, k + 1, peg);
+            for (d = 0; d < 3; d++) {
+                int i;
+                for (i = 0; i < top[d]; i++) if (peg[pegs[d][i]] != d) ok = 0;
+            }
+        }
+    }
+    return ok && top[2] == n;
+}
+
+void main() {
+    static const char pegName[] = "ABC";
+    unsigned char peg[MAX_DISKS + 1];
+    struct Move mv;
+    int n, choice, d, threads = 4;
+    unsigned long long k;
+    uint64_t sum;
+    double t;
+    clrscr();
+    do {
+        printf("\n1.Print Moves 2.K-th Move 3.Configuration After K Moves 4.Benchmark 5.Verify 6.Set Threads 7.Exit\nEnter choice: ");
+        if (scanf("%d", &choice) != 1) break;
+        switch (choice) {
+            case 1:
+                printf("Enter number of disks: ");
+                scanf("%d", &n);
+                if (n < 1 || n > 40) { printf("Invalid input"); break; }
+                printf("Tower of Hanoi moves:\n");
+                fflush(stdout);
+                printMoves(n);
+                break;
+            case 2:
+            case 3:
+                printf("Enter number of disks and k: ");
+                scanf("%d %llu", &n, &k);
+                if (n < 1 || n > MAX_DISKS || k >= (1ULL << n) - (choice == 2)) { printf("Invalid input"); break; }
+                if (choice == 2) {
+                    mv = kthMove(n, k);
+                    printf("Move %llu: disk %d from %c to %c", k + 1, mv.disk, pegName[mv.from], pegName[mv.to]);
+                }
+                else {
+                    configuration(n, k, peg);
+                    printf("After %llu moves:", k);
+                    for (d = 0; d < 3; d++) {
+                        int i;
+                        printf("\n%c:", pegName[d]);
+                        for (i = n; i >= 1; i--) if (peg[i] == d) printf(" %d", i);
+                    }
+                }
+                break;
+            case 4:
+                printf("Enter number of disks: ");
+                scanf("%d", &n);
+                if (n < 1 || n > 40) { printf("Invalid input"); break; }
+                t = now();
+                recSum = 0;
+                hanoiRec(n, 0, 1, 2);
+                printf("Recursive:             %.3f s\n", now() - t);
+                t = now();
+                sum = runParallel(n, 1);
+                printf("Iterative, 1 thread:   %.3f s\n", now() - t);
+                t = now();
+                sum = runParallel(n, threads) == sum ? sum : 0;
+                printf("Iterative, %d threads: %.3f s\n", threads, now() - t);
+                printf("Checksums %s", sum == recSum ? "match" : "DIFFER");
+                break;
+            case 5:
+                printf("Enter number of disks: ");
+                scanf("%d", &n);
+                if (n < 1 || n > 26) { printf("Invalid input"); break; }
+                printf("%s", verify(n) ? "All moves legal, tower ends on C" : "VERIFY FAILED");
+                break;
+            case 6:
+                printf("Enter number of threads: ");
+                scanf("%d", &threads);
+                if (threads < 1) threads = 1;
+                if (threads > MAX_THREADS) threads = MAX_THREADS;
+                break;
+            case 7: break;
+            default: printf("Invalid choice");
+        }
+    } while (choice != 7);
+    getch();
+}
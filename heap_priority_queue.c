@@ -0,0 +1,396 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <conio.h>
+#include <time.h>
+
+// Priority queue, higher priority dequeued first, in two variants that
+// share one handle space: enqueue returns a handle that can later be used
+// to change the element's priority or remove it.
+//   1. Array-backed d-ary heap: O(log n) enqueue/dequeue, O(n) bulk build.
+//      d = 4 keeps a node's children in one cache line.
+//   2. Pairing heap: O(1) enqueue and priority increase, O(log n)
+//      amortised dequeue; good when priorities change often.
+
+// Per-handle storage, shared by both variants
+int *data, *prio;
+int *pos;                    // d-ary: index in heap[], -1 when not queued
+int *child, *sibling, *prev; // pairing: prev is the parent for a first child
+int handles = 0, handleCap = 0;
+int *freeHandles, freeCount = 0;
+
+int newHandle(int item, int priority) {
+    int h;
+    if(freeCount > 0) h = freeHandles[--freeCount];
+    else {
+        if(handles == handleCap) {
+            handleCap = handleCap ? handleCap * 2 : 16;
+            data = (int*)realloc(data, handleCap * sizeof(int));
+            prio = (int*)realloc(prio, handleCap * sizeof(int));
+            pos = (int*)realloc(pos, handleCap * sizeof(int));
+            child = (int*)realloc(child, handleCap * sizeof(int));
+            sibling = (int*)realloc(sibling, handleCap * sizeof(int));
+            prev = (int*)realloc(prev, handleCap * sizeof(int));
+            freeHandles = (int*)realloc(freeHandles, handleCap * sizeof(int));
+            if(!data || !prio || !pos || !child || !sibling || !prev || !freeHandles) {
+                printf("\nPriority Queue Overflow");
+                exit(1);
+            }
+        }
+        h = handles++;
+    }
+    data[h] = item;
+    prio[h] = priority;
+    pos[h] = -1;
+    child[h] = sibling[h] = prev[h] = -1;
+    return h;
+}
+
+void releaseHandle(int h) {
+    pos[h] = -1;
+    freeHandles[freeCount++] = h;
+}
+
+// ---------- d-ary heap ----------
+
+int D = 4;
+int *heap = NULL;            // handles in heap order
+int heapSize = 0, heapCap = 0;
+
+void place(int i, int h) {
+    heap[i] = h;
+    pos[h] = i;
+}
+
+void siftUp(int i) {
+    int h = heap[i], p;
+    while(i > 0) {
+        p = (i - 1) / D;
+        if(prio[heap[p]] >= prio[h]) break;
+        place(i, heap[p]);
+        i = p;
+    }
+    place(i, h);
+}
+
+void siftDown(int i) {
+    int h = heap[i], c, best, k, last;
+    for(;;) {
+        c = i * D + 1;
+        if(c >= heapSize) break;
+        last = c + D < heapSize ? c + D : heapSize;
+        for(best = c, k = c + 1; k < last; k++)
+            if(prio[heap[k]] > prio[heap[best]]) best = k;
+        if(prio[heap[best]] <= prio[h]) break;
+        place(i, heap[best]);
+        i = best;
+    }
+    place(i, h);
+}
+
+void reserveHeap(int n) {
+    if(n <= heapCap) return;
+    while(heapCap < n) heapCap = heapCap ? heapCap * 2 : 16;
+    heap = (int*)realloc(heap, heapCap * sizeof(int));
+    if(!heap) { printf("\nPriority Queue Overflow"); exit(1); }
+}
+
+int heapPush(int item, int priority) {
+    int h = newHandle(item, priority);
+    reserveHeap(heapSize + 1);
+    place(heapSize, h);
+    siftUp(heapSize++);
+    return h;
+}
+
+// Add n items at once and restore heap order bottom-up in O(n)
+void heapPushBulk(int *items, int *priorities, int n, int *outHandles) {
+    int i;
+    reserveHeap(heapSize + n);
+    for(i = 0; i < n; i++) {
+        outHandles[i] = newHandle(items[i], priorities[i]);
+        place(heapSize++, outHandles[i]);
+    }
+    for(i = (heapSize - 2) / D; i >= 0; i--) siftDown(i);
+}
+
+// Remove handle h from the heap
+void heapRemove(int h) {
+    int i = pos[h], last = heap[--heapSize];
+    if(i != heapSize) {
+        place(i, last);
+        siftUp(i);
+        siftDown(pos[last]);
+    }
+    releaseHandle(h);
+}
+
+int heapPop(int *item, int *priority) {
+    if(heapSize == 0) return 0;
+    *item = data[heap[0]];
+    *priority = prio[heap[0]];
+    heapRemove(heap[0]);
+    return 1;
+}
+
+void heapChange(int h, int priority) {
+    int old = prio[h];
+    prio[h] = priority;
+    if(priority > old) siftUp(pos[h]);
+    else siftDown(pos[h]);
+}
+
+// ---------- Pairing heap ----------
+
+int root = -1, pairSize = 0;
+
+// Meld two heap-ordered trees, returns the new root
+int meld(int a, int b) {
+    int t;
+    if(a < 0) return b;
+    if(b < 0) return a;
+    if(prio[b] > prio[a]) { t = a; a = b; b = t; }
+    sibling[b] = child[a];
+    if(child[a] >= 0) prev[child[a]] = b;
+    prev[b] = a;
+    child[a] = b;
+    sibling[a] = prev[a] = -1;
+    return a;
+}
+
+// Detach the subtree rooted at h from its parent/sibling chain
+void cut(int h) {
+    if(prev[h] < 0) return;
+    if(child[prev[h]] == h) child[prev[h]] = sibling[h];
+    else sibling[prev[h]] = sibling[h];
+    if(sibling[h] >= 0) prev[sibling[h]] = prev[h];
+    sibling[h] = prev[h] = -1;
+}
+
+// Two-pass pairing of a child list: pair left to right, meld right to left
+int mergePairs(int first) {
+    int a, b, next, stack = -1, result = -1;
+    while(first >= 0) {
+        a = first;
+        b = sibling[a];
+        next = b >= 0 ? sibling[b] : -1;
+        sibling[a] = prev[a] = -1;
+        if(b >= 0) sibling[b] = prev[b] = -1;
+        a = meld(a, b);
+        sibling[a] = stack;   // reuse sibling as a stack link
+        stack = a;
+        first = next;
+    }
+    while(stack >= 0) {
+        next = sibling[stack];
+        sibling[stack] = -1;
+        result = meld(stack, result);
+        stack = next;
+    }
+    return result;
+}
+
+int pairPush(int item, int priority) {
+    int h = newHandle(item, priority);
+    root = meld(root, h);
+    pairSize++;
+    return h;
+}
+
+void pairRemove(int h) {
+    int sub;
+    if(h == root) root = mergePairs(child[h]);
+    else {
+        cut(h);
+        sub = mergePairs(child[h]);
+        root = meld(root, sub);
+    }
+    pairSize--;
+    releaseHandle(h);
+}
+
+int pairPop(int *item, int *priority) {
+    if(root < 0) return 0;
+    *item = data[root];
+    *priority = prio[root];
+    pairRemove(root);
+    return 1;
+}
+
+void pairChange(int h, int priority) {
+    int sub, old = prio[h];
+    prio[h] = priority;
+    if(h == root && priority >= old) return;
+    if(priority > old) {   // increase: cut the subtree and meld it back
+        cut(h);
+        root = meld(root, h);
+    }
+    else {                 // decrease: children may now beat h
+        if(h != root) cut(h);
+        else root = -1;
+        sub = mergePairs(child[h]);
+        child[h] = -1;
+        root = meld(meld(root, sub), h);
+    }
+}
+
+// ---------- Dispatch on the selected variant ----------
+
+int usePairing = 0;
+
+int isQueued(int h) {
+    if(h < 0 || h >= handles) return 0;
+    if(usePairing) return h == root || prev[h] >= 0;
+    return pos[h] >= 0;
+}
+
+int size() { return usePairing ? pairSize : heapSize; }
+
+int enqueue(int item, int priority) {
+    return usePairing ? pairPush(item, priority) : heapPush(item, priority);
+}
+
+int dequeue(int *item, int *priority) {
+    return usePairing ? pairPop(item, priority) : heapPop(item, priority);
+}
+
+void changePriority(int h, int priority) {
+    if(usePairing) pairChange(h, priority); else heapChange(h, priority);
+}
+
+void removeHandle(int h) {
+    if(usePairing) pairRemove(h); else heapRemove(h);
+}
+
+void clearAll() {
+    int item, p;
+    while(dequeue(&item, &p));
+    handles = freeCount = 0;
+    root = -1;
+}
+
+void showTree(int h) {
+    for(; h >= 0; h = sibling[h]) {
+        printf("%d-%d(#%d) ", data[h], prio[h], h);
+        showTree(child[h]);
+    }
+}
+
+void display() {
+    int i;
+    if(size() == 0) { printf("\nPriority Queue is Empty!"); return; }
+    printf("\nPriority Queue (Data-Priority(#handle)), %s order: ", usePairing ? "tree" : "heap");
+    if(usePairing) showTree(root);
+    else for(i = 0; i < heapSize; i++) printf("%d-%d(#%d) ", data[heap[i]], prio[heap[i]], heap[i]);
+}
+
+// n enqueues, n priority increases on random queued handles, n dequeues
+double runMix(int n, int *order) {
+    int *h = (int*)malloc(n * sizeof(int));
+    int i, k, item, p = 0, last = 0x7fffffff, ok = 1;
+    clock_t t = clock();
+    for(i = 0; i < n; i++) h[i] = enqueue(i, rand() % 1000000);
+    for(i = 0; i < n; i++) {
+        k = rand() % n;
+        changePriority(h[k], prio[h[k]] + rand() % 1000);
+    }
+    for(i = 0; i < n; i++) {
+        dequeue(&item, &p);
+        if(p > last) ok = 0;
+        last = p;
+    }
+    *order = ok;
+    free(h);
+    return (double)(clock() - t) / CLOCKS_PER_SEC;
+}
+
+void benchmark(int n) {
+    int d, ok, savedD = D, savedMode = usePairing;
+    int *items, *pr, *hs, i;
+    double secs;
+    clock_t t;
+    clearAll();
+    for(d = 2; d <= 8; d *= 2) {
+        D = d; usePairing = 0;
+        secs = runMix(n, &ok);
+        printf("\n%d-ary heap:    %.3f s%s", d, secs, ok ? "" : " ORDER ERROR");
+        clearAll();
+    }
+    usePairing = 1;
+    secs = runMix(n, &ok);
+    printf("\nPairing heap:  %.3f s%s", secs, ok ? "" : " ORDER ERROR");
+    clearAll();
+
+    usePairing = 0; D = 4;
+    items = (int*)malloc(n * sizeof(int)); pr = (int*)malloc(n * sizeof(int)); hs = (int*)malloc(n * sizeof(int));
+    for(i = 0; i < n; i++) { items[i] = i; pr[i] = rand(); }
+    t = clock();
+    for(i = 0; i < n; i++) heapPush(items[i], pr[i]);
+    printf("\n%d single enqueues: %.3f s", n, (double)(clock() - t) / CLOCKS_PER_SEC);
+    clearAll();
+    t = clock();
+    heapPushBulk(items, pr, n, hs);
+    printf("\nBulk heapify:       %.3f s", (double)(clock() - t) / CLOCKS_PER_SEC);
+    clearAll();
+    free(items); free(pr); free(hs);
+    D = savedD; usePairing = savedMode;
+}
+
+void main() {
+    int choice, item, p, h, n, i;
+    int *items, *pr, *hs;
+    clrscr();
+    do {
+        printf("\n===== Priority Queue (%s) =====\n", usePairing ? "pairing heap" : "d-ary heap");
+        printf("1. Enqueue\n2. Dequeue\n3. Change Priority\n4. Remove\n5. Display\n6. Bulk Enqueue\n7. Switch Variant / Set d (clears queue)\n8. Benchmark (clears queue)\n9. Exit\n");
+        printf("Enter your choice: ");
+        scanf("%d", &choice);
+        switch(choice) {
+            case 1:
+                printf("Enter data and priority: "); scanf("%d %d", &item, &p);
+                h = enqueue(item, p);
+                printf("\n%d enqueued with priority %d (handle %d)", item, p, h);
+                break;
+            case 2:
+                if(dequeue(&item, &p)) printf("\n%d dequeued (Priority: %d)", item, p);
+                else printf("\nPriority Queue is Empty!");
+                break;
+            case 3:
+                printf("Enter handle and new priority: "); scanf("%d %d", &h, &p);
+                if(!isQueued(h)) printf("\nInvalid handle");
+                else changePriority(h, p);
+                break;
+            case 4:
+                printf("Enter handle: "); scanf("%d", &h);
+                if(!isQueued(h)) printf("\nInvalid handle");
+                else { printf("\n%d removed", data[h]); removeHandle(h); }
+                break;
+            case 5: display(); break;
+            case 6:
+                printf("Enter count, then data and priority pairs: "); scanf("%d", &n);
+                if(n <= 0) break;
+                items = (int*)malloc(n * sizeof(int)); pr = (int*)malloc(n * sizeof(int)); hs = (int*)malloc(n * sizeof(int));
+                for(i = 0; i < n; i++) scanf("%d %d", &items[i], &pr[i]);
+                if(usePairing) for(i = 0; i < n; i++) hs[i] = pairPush(items[i], pr[i]);
+                else heapPushBulk(items, pr, n, hs);
+                printf("\nHandles: "); for(i = 0; i < n; i++) printf("%d ", hs[i]);
+                free(items); free(pr); free(hs);
+                break;
+            case 7:
+                clearAll();
+                printf("Enter 0 for pairing heap or d (>= 2) for a d-ary heap: "); scanf("%d", &n);
+                if(n == 0) usePairing = 1;
+                else if(n >= 2) { usePairing = 0; D = n; }
+                else printf("\nInvalid choice");
+                break;
+            case 8:
+                printf("Enter number of elements: "); scanf("%d", &n);
+                if(n > 0) benchmark(n);
+                break;
+            case 9: break;
+            default: printf("\nInvalid choice");
+        }
+    } while(choice != 9);
+    free(data); free(prio); free(pos); free(child); free(sibling); free(prev);
+    free(freeHandles); free(heap);
+    getch();
+}
@@ -0,0 +1,360 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "bytecode.h"
+
+// Streaming infix to postfix compiler (shunting-yard).
+//
+// The expression is fed in chunks of any size, so there is no length
+// limit and the whole text never has to be in memory. Operands are
+// multi-digit numbers and multi-character identifiers; operators are
+// + - * / ^ with ^ right-associative, plus unary - and +. The result is
+// bytecode (see bytecode.h), written straight into a buffer owned by the
+// caller.
+//
+// When the buffer fills up, compileFeed/compileFinish return C_FULL
+// without losing state; the caller enlarges or drains c->out (adjusting
+// c->cap / c->len) and calls again with the unconsumed input.
+
+enum { LPAREN = OP_COUNT };
+enum { C_OK, C_FULL, C_ERROR };
+enum { T_NONE, T_NUM, T_NAME };
+
+
+struct Compiler {
+    long long *out;        // caller's bytecode buffer
+    long cap, len;
+    unsigned char *ops;    // operator stack
+    int opTop, opCap;
+    char *names;           // identifier text, NUL separated
+    long namesLen, namesCap;
+    long *nameAt;          // offset of each variable's name
+    int nVars, varCap;
+    int *hash;             // open addressing: variable index + 1, 0 = empty
+    int hashCap;
+    int token;             // token being scanned across chunk boundaries
+    long long num;
+    long nameFrom;
+    long long pending;     // finished operand waiting for buffer space
+    int hasPending;
+    int expectOperand;
+    long pos;              // characters consumed so far
+    const char *error;
+};
+
+int precedence(int op) {   // Function to return precedence of operators
+    switch (op) {
+        case OP_POW: return 4;
+        case OP_NEG: return 3;
+        case OP_MUL:
+        case OP_DIV: return 2;
+        case OP_ADD:
+        case OP_SUB: return 1;
+        default: return 0;
+    }
+}
+
+void compilerInit(struct Compiler *c, long long *out, long cap) {
+    memset(c, 0, sizeof(*c));
+    c->out = out;
+    c->cap = cap;
+    c->opTop = -1;
+    c->expectOperand = 1;
+}
+
+void compilerFree(struct Compiler *c) {
+    free(c->ops);
+    free(c->names);
+    free(c->nameAt);
+    free(c->hash);
+}
+
+void *grow(void *p, size_t size) {
+    p = realloc(p, size);
+    if (p == NULL) { printf("Out of memory\n"); exit(1); }
+    return p;
+}
+
+int fail(struct Compiler *c, const char *msg) {
+    c->error = msg;
+    return C_ERROR;
+}
+
+int emit(struct Compiler *c, long long w) {
+    if (c->len == c->cap) return 0;
+    c->out[c->len++] = w;
+    return 1;
+}
+
+void pushOp(struct Compiler *c, int op) {
+    if (c->opTop + 1 == c->opCap) {
+        c->opCap = c->opCap ? c->opCap * 2 : 64;
+        c->ops = (unsigned char*)grow(c->ops, c->opCap);
+    }
+    c->ops[++c->opTop] = (unsigned char)op;
+}
+
+void appendName(struct Compiler *c, char ch) {
+    if (c->namesLen == c->namesCap) {
+        c->namesCap = c->namesCap ? c->namesCap * 2 : 256;
+        c->names = (char*)grow(c->names, c->namesCap);
+    }
+    c->names[c->namesLen++] = ch;
+}
+
+unsigned hashName(const char *s) {
+    unsigned h = 2166136261u;
+    while (*s) h = (h ^ (unsigned char)*s++) * 16777619u;
+    return h;
+}
+
+// Variable index of the name just scanned, adding it if new
+int intern(struct Compiler *c) {
+    const char *name;
+    unsigned i;
+    int v;
+    appendName(c, '\0');
+    name = c->names + c->nameFrom;
+    if (c->nVars * 2 >= c->hashCap) {   // rebuild at half load
+        c->hashCap = c->hashCap ? c->hashCap * 2 : 64;
+        c->hash = (int*)grow(c->hash, c->hashCap * sizeof(int));
+        memset(c->hash, 0, c->hashCap * sizeof(int));
+        for (v = 0; v < c->nVars; v++) {
+            for (i = hashName(c->names + c->nameAt[v]) & (c->hashCap - 1); c->hash[i]; i = (i + 1) & (c->hashCap - 1));
+            c->hash[i] = v + 1;
+        }
+    }
+    for (i = hashName(name) & (c->hashCap - 1); c->hash[i]; i = (i + 1) & (c->hashCap - 1)) {
+        v = c->hash[i] - 1;
+        if (strcmp(c->names + c->nameAt[v], name) == 0) {
+            c->namesLen = c->nameFrom;   // already known: drop the copy
+            return v;
+        }
+    }
+    if (c->nVars == c->varCap) {
+        c->varCap = c->varCap ? c->varCap * 2 : 16;
+        c->nameAt = (long*)grow(c->nameAt, c->varCap * sizeof(long));
+    }
+    c->nameAt[c->nVars] = c->nameFrom;
+    c->hash[i] = c->nVars + 1;
+    return c->nVars++;
+}
+
+// Turn a finished number or name into a pending operand word
+void endToken(struct Compiler *c) {
+    if (c->token == T_NUM) c->pending = CODE(OP_NUM, c->num);
+    else if (c->token == T_NAME) c->pending = CODE(OP_VAR, intern(c));
+    else return;
+    c->token = T_NONE;
+    c->hasPending = 1;
+    c->expectOperand = 0;
+}
+
+// Process one character. State only changes once the output it needs has
+// been written, so after C_FULL the same character can simply be retried.
+int step(struct Compiler *c, char ch) {
+    int op;
+    if (c->token == T_NUM) {
+        if (isdigit((unsigned char)ch)) {
+            if (c->num > (CODE_ARG_MAX - (ch - '0')) / 10) return fail(c, "number too large");
+            c->num = c->num * 10 + (ch - '0');
+            return C_OK;
+        }
+        if (isalpha((unsigned char)ch) || ch == '_') return fail(c, "letter inside number");
+    }
+    else if (c->token == T_NAME && (isalnum((unsigned char)ch) || ch == '_')) {
+        appendName(c, ch);
+        return C_OK;
+    }
+    endToken(c);
+    if (c->hasPending) {
+        if (!emit(c, c->pending)) return C_FULL;
+        c->hasPending = 0;
+    }
+
+    if (isspace((unsigned char)ch)) return C_OK;
+    if (isdigit((unsigned char)ch) || isalpha((unsigned char)ch) || ch == '_') {   // start of an operand
+        if (!c->expectOperand) return fail(c, "missing operator");
+        if (isdigit((unsigned char)ch)) { c->token = T_NUM; c->num = ch - '0'; }
+        else { c->token = T_NAME; c->nameFrom = c->namesLen; appendName(c, ch); }
+        return C_OK;
+    }
+    if (ch == '(') {
+        if (!c->expectOperand) return fail(c, "missing operator");
+        pushOp(c, LPAREN);
+        return C_OK;
+    }
+    if (ch == ')') {   // pop and output until '('
+        if (c->expectOperand) return fail(c, "missing operand");
+        while (c->opTop >= 0 && c->ops[c->opTop] != LPAREN) {
+            if (!emit(c, CODE(c->ops[c->opTop], 0))) return C_FULL;
+            c->opTop--;
+        }
+        if (c->opTop < 0) return fail(c, "unmatched ')'");
+        c->opTop--;
+        return C_OK;
+    }
+    switch (ch) {
+        case '+': op = OP_ADD; break;
+        case '-': op = OP_SUB; break;
+        case '*': op = OP_MUL; break;
+        case '/': op = OP_DIV; break;
+        case '^': op = OP_POW; break;
+        default: return fail(c, "unexpected character");
+    }
+    if (c->expectOperand) {   // prefix position: unary operator
+        if (op == OP_SUB) pushOp(c, OP_NEG);
+        else if (op != OP_ADD) return fail(c, "missing operand");
+        return C_OK;
+    }
+    // Pop operators that bind tighter; equal precedence only if left-associative
+    while (c->opTop >= 0 && c->ops[c->opTop] != LPAREN &&
+           (precedence(c->ops[c->opTop]) > precedence(op) ||
+            (precedence(c->ops[c->opTop]) == precedence(op) && op != OP_POW))) {
+        if (!emit(c, CODE(c->ops[c->opTop], 0))) return C_FULL;
+        c->opTop--;
+    }
+    pushOp(c, op);
+    c->expectOperand = 1;
+    return C_OK;
+}
+
+// Feed the next n characters; *used reports how many were consumed
+int compileFeed(struct Compiler *c, const char *text, long n, long *used) {
+    long i;
+    int r = C_OK;
+    for (i = 0; i < n; i++) {
+        r = step(c, text[i]);
+        if (r != C_OK) break;
+    }
+    c->pos += i;
+    *used = i;
+    return r;
+}
+
+// End of input: flush the last operand and the operator stack
+int compileFinish(struct Compiler *c) {
+    endToken(c);
+    if (c->hasPending) {
+        if (!emit(c, c->pending)) return C_FULL;
+        c->hasPending = 0;
+    }
+    if (c->expectOperand) return fail(c, "missing operand");
+    while (c->opTop >= 0) {
+        if (c->ops[c->opTop] == LPAREN) return fail(c, "unmatched '('");
+        if (!emit(c, CODE(c->ops[c->opTop], 0))) return C_FULL;
+        c->opTop--;
+    }
+    return C_OK;
+}
+
+// Feed a chunk (text NULL: finish), doubling *buf whenever the compiler
+// reports C_FULL
+int feedAll(struct Compiler *c, const char *text, long n, long long **buf) {
+    long used;
+    int r;
+    for (;;) {
+        r = text ? compileFeed(c, text, n, &used) : compileFinish(c);
+        if (r != C_FULL) return r;
+        if (text) { text += used; n -= used; }
+        c->cap *= 2;
+        *buf = (long long*)grow(*buf, c->cap * sizeof(long long));
+        c->out = *buf;
+    }
+}
+
+void printPostfix(struct Compiler *c, long long *code, long n) {
+    static const char sym[] = "??+-*/^~";
+    long i;
+    printf("Postfix Expression: ");
+    for (i = 0; i < n; i++) {
+        switch (CODE_OP(code[i])) {
+            case OP_NUM: printf("%lld ", CODE_ARG(code[i])); break;
+            case OP_VAR: printf("%s ", c->names + c->nameAt[CODE_ARG(code[i])]); break;
+            default: printf("%c ", sym[CODE_OP(code[i])]);   // ~ is unary minus
+        }
+    }
+    printf("\n%ld bytecode words, %d variables\n", n, c->nVars);
+}
+
+// Write the next piece of a generated formula of the form
+// "v0 * (12 - -v1) ^ 2 ^ 3 / 7 + v2 * ..." into chunk
+long generate(char *chunk, long size, long *term, long terms) {
+    long len = 0;
+    while (*term < terms && len + 64 < size) {
+        len += sprintf(chunk + len, "%sv%ld * (%ld - -v%ld) ^ 2 ^ 3 / 7", *term ? " + " : "",
+                       *term % 1000, *term % 97 + 1, (*term + 1) % 1000);
+        (*term)++;
+    }
+    return len;
+}
+
+void benchmark(long terms) {
+    static char chunk[65536];
+    struct Compiler c;
+    long long *buf;
+    long term = 0, n, bytes = 0;
+    clock_t t = clock();
+    double secs;
+    int r = C_OK;
+    buf = (long long*)grow(NULL, 1024 * sizeof(long long));
+    compilerInit(&c, buf, 1024);
+    while (r == C_OK && (n = generate(chunk, sizeof(chunk), &term, terms)) > 0) {
+        r = feedAll(&c, chunk, n, &buf);
+        bytes += n;
+    }
+    if (r == C_OK) r = feedAll(&c, NULL, 0, &buf);
+    secs = (double)(clock() - t) / CLOCKS_PER_SEC;
+    if (r != C_OK) printf("Error at %ld: %s\n", c.pos, c.error);
+    else printf("%ld chars -> %ld words, %d variables: %.3f s (%.1f MB/s, including generation)\n",
+                bytes, c.len, c.nVars, secs, bytes / 1e6 / (secs > 0 ? secs : 1e-9));
+    compilerFree(&c);
+    free(buf);
+}
+
+void main() {
+    char chunk[256];
+    struct Compiler c;
+    long long *buf;
+    long n, len;
+    int choice, r, done;
+    clrscr();
+    do {
+        printf("\n1.Convert Expression 2.Benchmark 3.Exit\nEnter choice: ");
+        if (scanf("%d", &choice) != 1) break;
+        getchar();
+        switch (choice) {
+            case 1:
+                printf("Enter an Infix Expression: ");
+                buf = (long long*)grow(NULL, 16 * sizeof(long long));
+                compilerInit(&c, buf, 16);
+                r = C_OK;
+                done = 0;
+                while (!done && r == C_OK && fgets(chunk, sizeof(chunk), stdin)) {   // line of any length
+                    len = strlen(chunk);
+                    if (len > 0 && chunk[len - 1] == '\n') { len--; done = 1; }
+                    r = feedAll(&c, chunk, len, &buf);
+                }
+                if (r == C_OK) r = feedAll(&c, NULL, 0, &buf);
+                if (r == C_OK) printPostfix(&c, buf, c.len);
+                else {
+                    printf("Error at character %ld: %s\n", c.pos + 1, c.error);
+                    if (!done) while ((r = getchar()) != '\n' && r != EOF);
+                }
+                compilerFree(&c);
+                free(buf);
+                break;
+            case 2:
+                printf("Enter number of terms: ");
+                scanf("%ld", &n);
+                if (n > 0) benchmark(n);
+                break;
+            case 3: break;
+            default: printf("Invalid choice");
+        }
+    } while (choice != 3);
+    getch();
+}
@@ -1,19 +1,22 @@
 #include <stdio.h>
-#include <conio.h>
+#include <stdlib.h>
 #include <math.h>
+#include "fast_io.h"
 
 void main() {
-    int arr[20], n, i, key, step, prev, found=0;
-    clrscr();
+    int *arr, n, i, key, step, prev, found=0;
+    startIO();
     
-    printf("Enter number of elements (sorted): ");
-    scanf("%d",&n);
+    prompt("Enter number of elements (sorted): ");
+    if(!readInt(&n) || n < 0) { writeStr("Invalid input\n"); endIO(); return; }
+    arr = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if(arr == NULL) { writeStr("Out of memory\n"); endIO(); return; }
     
-    printf("Enter sorted elements: ");
-    for(i=0;i<n;i++) scanf("%d",&arr[i]);
+    prompt("Enter sorted elements: ");
+    if(!readInts(arr, n)) { writeStr("Invalid input\n"); free(arr); endIO(); return; }
     
-    printf("Enter element to search: ");
-    scanf("%d",&key);
+    prompt("Enter element to search: ");
+    if(!readInt(&key)) { writeStr("Invalid input\n"); free(arr); endIO(); return; }
     
     step = sqrt(n);
     prev = 0;
@@ -27,8 +30,9 @@ void main() {
         if(arr[i]==key){ found=1; break; }
     }
     
-    if(found) printf("Element found at position %d\n", i+1);
-    else printf("Element not found\n");
+    if(found) { writeStr("Element found at position "); writeInt(i+1); writeChar('\n'); }
+    else writeStr("Element not found\n");
     
-    getch();
+    free(arr);
+    endIO();
 }
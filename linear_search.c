@@ -1,19 +1,21 @@
 #include <stdio.h>
-#include <conio.h>
+#include <stdlib.h>
+#include "fast_io.h"
 
 void main() {
-    int arr[10], n, i, key, found=0;
-    clrscr();
+    int *arr, n, i, key, found=0;
+    startIO();
     
-    printf("Enter number of elements: ");
-    scanf("%d",&n);
+    prompt("Enter number of elements: ");
+    if(!readInt(&n) || n < 0) { writeStr("Invalid input\n"); endIO(); return; }
+    arr = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if(arr == NULL) { writeStr("Out of memory\n"); endIO(); return; }
     
-    printf("Enter elements: ");
-    for(i=0;i<n;i++)
-        scanf("%d",&arr[i]);
+    prompt("Enter elements: ");
+    if(!readInts(arr, n)) { writeStr("Invalid input\n"); free(arr); endIO(); return; }
     
-    printf("Enter element to search: ");
-    scanf("%d",&key);
+    prompt("Enter element to search: ");
+    if(!readInt(&key)) { writeStr("Invalid input\n"); free(arr); endIO(); return; }
     
     for(i=0;i<n;i++) {
         if(arr[i]==key) {
@@ -22,9 +24,12 @@ void main() {
         }
     }
     
-    if(found)
-        printf("Element found at position %d", i+1);
+    if(found) {
+        writeStr("Element found at position ");
+        writeInt(i+1);
+    }
     else
-        printf("Element not found");
-    getch();
+        writeStr("Element not found");
+    free(arr);
+    endIO();
 }
@@ -0,0 +1,312 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define GAP (1LL << 20)   // spacing of order labels between neighbouring nodes
+
+struct Node {
+    int data;
+    struct Node *next, *prev;
+    struct Node *dupNext, *dupPrev;   // other nodes holding the same value, in list order
+    long long ord;                    // increasing along the list
+};
+
+struct Node *head = NULL, *tail = NULL;
+
+// Open addressing index: value -> chain of nodes holding that value.
+// Linear probing with backward shift deletion, capacity is a power of two.
+// Each chain is kept in list order, so the slot points at the first
+// occurrence; the first node's dupPrev points at the last one, so adding
+// at either end of the chain is O(1). Only a duplicate inserted between
+// two others walks the chain (from the back).
+int *keys = NULL;
+struct Node **slots = NULL;
+int cap = 0, capBits = 0, used = 0;   // cap == 1 << capBits
+int indexOn = 1;   // 1 = O(1) lookups, 0 = free the table (12 bytes a slot) and scan
+
+// Fibonacci hashing: the top bits of the product depend on every bit of
+// the key, the low bits only on the low bits (strided keys would collide)
+unsigned hashSlot(int val) {
+    return ((unsigned)val * 2654435761u) >> (32 - capBits);
+}
+
+int indexFind(int val) {
+    unsigned i = hashSlot(val);
+    while(slots[i] != NULL) {
+        if(keys[i] == val) return i;
+        i = (i + 1) & (cap - 1);
+    }
+    return -1;
+}
+
+void indexAdd(struct Node *node);
+
+void indexGrow() {
+    int oldCap = cap, i;
+    int *oldKeys = keys;
+    struct Node **oldSlots = slots;
+    capBits = oldCap ? capBits + 1 : 4;
+    cap = 1 << capBits;
+    keys = (int*)malloc(cap * sizeof(int));
+    slots = (struct Node**)calloc(cap, sizeof(struct Node*));
+    if(keys == NULL || slots == NULL) { printf("OVERFLOW\n"); exit(1); }
+    used = 0;
+    for(i = 0; i < oldCap; i++)
+        if(oldSlots[i] != NULL) {
+            unsigned j = hashSlot(oldKeys[i]);
+            while(slots[j] != NULL) j = (j + 1) & (cap - 1);
+            keys[j] = oldKeys[i];
+            slots[j] = oldSlots[i];
+            used++;
+        }
+    free(oldKeys);
+    free(oldSlots);
+}
+
+void indexAdd(struct Node *node) {
+    unsigned i;
+    struct Node *first, *last, *x;
+    if((used + 1) * 10 > cap * 7) indexGrow();   // keep load below 0.7
+    i = hashSlot(node->data);
+    while(slots[i] != NULL && keys[i] != node->data) i = (i + 1) & (cap - 1);
+    if(slots[i] == NULL) {
+        keys[i] = node->data;
+        used++;
+        slots[i] = node;
+        node->dupNext = NULL;
+        node->dupPrev = node;
+        return;
+    }
+    first = slots[i];
+    last = first->dupPrev;
+    if(node->ord > last->ord) {            // new last occurrence
+        last->dupNext = node;
+        node->dupPrev = last;
+        node->dupNext = NULL;
+        first->dupPrev = node;
+    }
+    else if(node->ord < first->ord) {      // new first occurrence
+        node->dupNext = first;
+        node->dupPrev = last;
+        first->dupPrev = node;
+        slots[i] = node;
+    }
+    else {                                 // between two duplicates
+        for(x = last; x->dupPrev->ord > node->ord; x = x->dupPrev);
+        node->dupPrev = x->dupPrev;
+        node->dupNext = x;
+        x->dupPrev->dupNext = node;
+        x->dupPrev = node;
+    }
+}
+
+void indexRemove(struct Node *node) {
+    unsigned i = indexFind(node->data), j, k;
+    struct Node *first = slots[i];
+    if(node != first) {
+        node->dupPrev->dupNext = node->dupNext;
+        if(node->dupNext != NULL) node->dupNext->dupPrev = node->dupPrev;
+        else first->dupPrev = node->dupPrev;   // node was the last occurrence
+        return;
+    }
+    if(node->dupNext != NULL) {
+        node->dupNext->dupPrev = node->dupPrev;
+        slots[i] = node->dupNext;
+        return;
+    }
+    // Last node with this value: empty the slot and shift the probe run back
+    slots[i] = NULL;
+    used--;
+    for(j = (i + 1) & (cap - 1); slots[j] != NULL; j = (j + 1) & (cap - 1)) {
+        k = hashSlot(keys[j]);
+        if(((j - k) & (cap - 1)) >= ((j - i) & (cap - 1))) {
+            keys[i] = keys[j];
+            slots[i] = slots[j];
+            slots[j] = NULL;
+            i = j;
+        }
+    }
+}
+
+void indexBuild() {
+    struct Node *temp;
+    for(temp = head; temp != NULL; temp = temp->next) indexAdd(temp);
+}
+
+void indexFree() {
+    free(keys); free(slots);
+    keys = NULL; slots = NULL;
+    cap = capBits = used = 0;
+}
+
+// Give every node a fresh, evenly spaced order label
+void relabel() {
+    struct Node *temp;
+    long long o = 0;
+    for(temp = head; temp != NULL; temp = temp->next) { temp->ord = o; o += GAP; }
+}
+
+// Make room around node (whose own label is ignored): grow a window of
+// nodes outward from it until the labels just outside the window leave a
+// spacing of at least the window size, then spread the window evenly.
+// Only the nodes near the crowded spot are touched; the whole list is
+// relabelled only when the window covers all of it.
+void relabelAround(struct Node *node) {
+    struct Node *lo = node, *hi = node, *temp;
+    long long count = 1, a, b, step, o;
+    for(;;) {
+        a = lo->prev ? lo->prev->ord : lo->ord - GAP * count;
+        b = hi->next ? hi->next->ord : hi->ord + GAP * count;
+        if(lo != node || hi != node)   // node's label is not valid yet
+            if((b - a) / (count + 1) >= count) break;
+        if(lo->prev == NULL && hi->next == NULL) { relabel(); return; }
+        if(lo->prev) { lo = lo->prev; count++; }
+        if(hi->next) { hi = hi->next; count++; }
+    }
+    step = (b - a) / (count + 1);
+    for(temp = lo, o = a + step; temp != hi->next; temp = temp->next, o += step) temp->ord = o;
+}
+
+// First node in list order holding val, or NULL
+struct Node *findFirst(int val) {
+    struct Node *temp;
+    int i;
+    if(indexOn) {
+        if(cap == 0 || (i = indexFind(val)) < 0) return NULL;
+        return slots[i];
+    }
+    for(temp = head; temp != NULL; temp = temp->next)
+        if(temp->data == val) return temp;
+    return NULL;
+}
+
+// Link a new node holding val after node p (p == NULL means at the front)
+void linkAfter(struct Node *p, int val) {
+    struct Node *newNode = (struct Node*)malloc(sizeof(struct Node));
+    struct Node *n = p ? p->next : head;
+    if(newNode == NULL) { printf("OVERFLOW\n"); return; }
+    newNode->data = val;
+    newNode->prev = p;
+    newNode->next = n;
+    if(p) p->next = newNode; else head = newNode;
+    if(n) n->prev = newNode; else tail = newNode;
+
+    if(p == NULL && n == NULL) newNode->ord = 0;
+    else if(p == NULL) newNode->ord = n->ord - GAP;
+    else if(n == NULL) newNode->ord = p->ord + GAP;
+    else if(n->ord - p->ord > 1) newNode->ord = p->ord + (n->ord - p->ord) / 2;
+    else relabelAround(newNode);   // no free label between p and n
+
+    if(indexOn) indexAdd(newNode);
+}
+
+void unlink(struct Node *node) {
+    if(node->prev) node->prev->next = node->next; else head = node->next;
+    if(node->next) node->next->prev = node->prev; else tail = node->prev;
+    if(indexOn) indexRemove(node);
+    free(node);
+}
+
+// Insertion
+void insertFront(int val) { linkAfter(NULL, val); }
+
+void insertEnd(int val) { linkAfter(tail, val); }
+
+void insertAfter(int val, int after) {
+    struct Node *temp = findFirst(after);
+    if(temp == NULL) printf("Element %d not found\n", after);
+    else linkAfter(temp, val);
+}
+
+// Deletion
+void deleteFront() {
+    if(head == NULL) { printf("List is empty\n"); return; }
+    printf("Deleted element: %d\n", head->data);
+    unlink(head);
+}
+
+void deleteEnd() {
+    if(head == NULL) { printf("List is empty\n"); return; }
+    printf("Deleted element: %d\n", tail->data);
+    unlink(tail);
+}
+
+void deleteValue(int val) {
+    struct Node *temp;
+    if(head == NULL) { printf("List is empty\n"); return; }
+    temp = findFirst(val);
+    if(temp == NULL) printf("Element %d not found\n", val);
+    else { unlink(temp); printf("Deleted %d\n", val); }
+}
+
+// Search
+// The lookup is O(1); counting the position still walks to the node
+void search(int val) {
+    struct Node *node = findFirst(val), *temp;
+    int pos = 1;
+    if(node == NULL) { printf("Element %d not found\n", val); return; }
+    for(temp = head; temp != node; temp = temp->next) pos++;
+    printf("Element %d found at position %d\n", val, pos);
+}
+
+// Display
+void display() {
+    struct Node *temp = head;
+    if(temp == NULL) { printf("List is empty\n"); return; }
+    printf("Linked list: ");
+    while(temp != NULL) { printf("%d ", temp->data); temp = temp->next; }
+    printf("\n");
+}
+
+// Turning the index off frees the slot table only; the nodes keep their
+// duplicate links and order labels so the index can be rebuilt in O(n)
+void toggleIndex() {
+    long freed = (long)cap * (sizeof(int) + sizeof(struct Node*));
+    indexOn = !indexOn;
+    if(indexOn) { indexBuild(); printf("Hash index ON (fast lookups)\n"); }
+    else { indexFree(); printf("Hash index OFF (%ld bytes of table freed)\n", freed); }
+}
+
+// Benchmark: n inserts, then n lookups and n deletes by value
+void benchmark(int n) {
+    clock_t t;
+    int i, on;
+    for(on = 0; on <= 1; on++) {
+        if(indexOn != on) toggleIndex();
+        t = clock();
+        for(i = 0; i < n; i++) insertEnd(i);
+        for(i = 0; i < n; i++) findFirst(n - 1 - i);
+        for(i = n - 1; i >= 0; i--) unlink(findFirst(i));
+        printf("Index %s: %.3f s\n", on ? "ON " : "OFF", (double)(clock() - t) / CLOCKS_PER_SEC);
+    }
+}
+
+void main() {
+    int choice, val, after, n;
+    clrscr();
+    do {
+        printf("\n===== Hash Indexed Linked List Menu =====\n");
+        printf("1. Insert Front\n2. Insert End\n3. Insert After\n4. Delete Front\n5. Delete End\n6. Delete Value\n7. Search\n8. Display\n9. Toggle Index\n10. Benchmark (list must be empty)\n11. Exit\n");
+        printf("Enter your choice: ");
+        scanf("%d",&choice);
+        switch(choice) {
+            case 1: printf("Enter value: "); scanf("%d",&val); insertFront(val); break;
+            case 2: printf("Enter value: "); scanf("%d",&val); insertEnd(val); break;
+            case 3: printf("Enter value and after element: "); scanf("%d %d",&val,&after); insertAfter(val, after); break;
+            case 4: deleteFront(); break;
+            case 5: deleteEnd(); break;
+            case 6: printf("Enter value to delete: "); scanf("%d",&val); deleteValue(val); break;
+            case 7: printf("Enter value to search: "); scanf("%d",&val); search(val); break;
+            case 8: display(); break;
+            case 9: toggleIndex(); break;
+            case 10:
+                if(head != NULL) { printf("List is not empty\n"); break; }
+                printf("Enter number of elements: "); scanf("%d",&n); benchmark(n);
+                break;
+            case 11: break;
+            default: printf("Invalid choice\n");
+        }
+    } while(choice != 11);
+    getch();
+}
@@ -0,0 +1,346 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+// Lock-free sorted linked list (Harris-Michael). The low bit of a node's
+// next pointer marks that node as logically deleted; any thread that sees
+// a marked node unlinks it. Unlinked nodes are freed with epoch based
+// reclamation once no thread can still be reading them.
+
+#define MAX_THREADS 65      // 64 workers + the menu thread (tid 0)
+#define ADVANCE_EVERY 32    // operations between attempts to advance the epoch
+
+struct LNode {
+    int key;
+    _Atomic uintptr_t next;
+    struct LNode *retireNext;      // link in a limbo list, never read concurrently
+    unsigned long retireEpoch;     // global epoch when the node was unlinked
+};
+
+#define MARKED(p)   ((p) & 1)
+#define PTR(p)      ((struct LNode*)((p) & ~(uintptr_t)1))
+
+struct LNode head = { INT_MIN, 0, NULL, 0 };
+
+// Epoch based reclamation: a node unlinked in epoch e can be freed once the
+// global epoch reaches e + 2, since every thread active at e has left by then.
+struct EpochRec {
+    _Atomic unsigned long state;   // (epoch << 1) | active
+    struct LNode *limboHead, *limboTail;   // retired nodes, oldest first
+    int ops;
+    char pad[64];
+};
+
+_Atomic unsigned long globalEpoch = 0;
+struct EpochRec rec[MAX_THREADS];
+
+void freeLimbo(struct EpochRec *r, unsigned long upTo) {
+    struct LNode *n;
+    while(r->limboHead != NULL && r->limboHead->retireEpoch + 2 <= upTo) {
+        n = r->limboHead;
+        r->limboHead = n->retireNext;
+        free(n);
+    }
+    if(r->limboHead == NULL) r->limboTail = NULL;
+}
+
+void tryAdvance() {
+    unsigned long e = atomic_load(&globalEpoch), s;
+    int i;
+    for(i = 0; i < MAX_THREADS; i++) {
+        s = atomic_load(&rec[i].state);
+        if((s & 1) && (s >> 1) != e) return;
+    }
+    atomic_compare_exchange_strong(&globalEpoch, &e, e + 1);
+}
+
+void enter(int tid) {
+    struct EpochRec *r = &rec[tid];
+    unsigned long e;
+    if(++r->ops % ADVANCE_EVERY == 0) tryAdvance();
+    do {   // publish an epoch that is still current after the store
+        e = atomic_load(&globalEpoch);
+        atomic_store(&r->state, (e << 1) | 1);
+    } while(atomic_load(&globalEpoch) != e);
+    freeLimbo(r, e);
+}
+
+void leave(int tid) {
+    atomic_store(&rec[tid].state, 0);
+}
+
+void retire(int tid, struct LNode *n) {
+    struct EpochRec *r = &rec[tid];
+    n->retireEpoch = atomic_load(&globalEpoch);
+    n->retireNext = NULL;
+    if(r->limboTail != NULL) r->limboTail->retireNext = n;
+    else r->limboHead = n;
+    r->limboTail = n;
+}
+
+// Find the first node with key >= key, unlinking marked nodes on the way.
+// On return *prevp is the link that pointed to *curp.
+int find(int tid, int key, _Atomic uintptr_t **prevp, struct LNode **curp) {
+    _Atomic uintptr_t *prev;
+    struct LNode *cur;
+    uintptr_t next, expected;
+retry:
+    prev = &head.next;
+    cur = PTR(atomic_load(prev));
+    while(cur != NULL) {
+        next = atomic_load(&cur->next);
+        if(MARKED(next)) {
+            expected = (uintptr_t)cur;
+            if(!atomic_compare_exchange_strong(prev, &expected, next & ~(uintptr_t)1)) goto retry;
+            retire(tid, cur);
+            cur = PTR(next);
+            continue;
+        }
+        if(cur->key >= key) break;
+        prev = &cur->next;
+        cur = PTR(next);
+    }
+    *prevp = prev;
+    *curp = cur;
+    return cur != NULL && cur->key == key;
+}
+
+int listInsert(int tid, int key) {
+    _Atomic uintptr_t *prev;
+    struct LNode *cur, *n = NULL;
+    uintptr_t expected;
+    enter(tid);
+    for(;;) {
+        if(find(tid, key, &prev, &cur)) { free(n); leave(tid); return 0; }
+        if(n == NULL) {
+            n = (struct LNode*)malloc(sizeof(struct LNode));
+            if(n == NULL) { printf("OVERFLOW\n"); exit(1); }
+            n->key = key;
+        }
+        atomic_store(&n->next, (uintptr_t)cur);
+        expected = (uintptr_t)cur;
+        if(atomic_compare_exchange_strong(prev, &expected, (uintptr_t)n)) { leave(tid); return 1; }
+    }
+}
+
+int listDelete(int tid, int key) {
+    _Atomic uintptr_t *prev;
+    struct LNode *cur;
+    uintptr_t next, expected;
+    enter(tid);
+    for(;;) {
+        if(!find(tid, key, &prev, &cur)) { leave(tid); return 0; }
+        next = atomic_load(&cur->next);
+        if(MARKED(next)) continue;
+        if(!atomic_compare_exchange_strong(&cur->next, &next, next | 1)) continue;
+        expected = (uintptr_t)cur;
+        if(atomic_compare_exchange_strong(prev, &expected, next)) retire(tid, cur);
+        else find(tid, key, &prev, &cur);   // let find() unlink it
+        leave(tid);
+        return 1;
+    }
+}
+
+int listContains(int tid, int key) {
+    struct LNode *cur;
+    int found;
+    enter(tid);
+    cur = PTR(atomic_load(&head.next));
+    while(cur != NULL && cur->key < key) cur = PTR(atomic_load(&cur->next));
+    found = cur != NULL && cur->key == key && !MARKED(atomic_load(&cur->next));
+    leave(tid);
+    return found;
+}
+
+// Only called while no worker threads run
+void display() {
+    struct LNode *cur = PTR(atomic_load(&head.next));
+    if(cur == NULL) { printf("List is empty\n"); return; }
+    printf("Sorted list: ");
+    for(; cur != NULL; cur = PTR(atomic_load(&cur->next)))
+        if(!MARKED(atomic_load(&cur->next))) printf("%d ", cur->key);
+    printf("\n");
+}
+
+void clearList() {
+    struct LNode *cur = PTR(atomic_load(&head.next)), *n;
+    int i;
+    while(cur != NULL) { n = PTR(atomic_load(&cur->next)); free(cur); cur = n; }
+    atomic_store(&head.next, 0);
+    for(i = 0; i < MAX_THREADS; i++) freeLimbo(&rec[i], (unsigned long)-1 / 2);
+}
+
+// Mutex baseline: the plain sorted list behind one lock
+struct Node {
+    int data;
+    struct Node *next;
+};
+
+struct Node *lockedHead = NULL;
+pthread_mutex_t listLock = PTHREAD_MUTEX_INITIALIZER;
+
+int lockedOp(int op, int key) {
+    struct Node **pp, *n;
+    int r = 0;
+    pthread_mutex_lock(&listLock);
+    for(pp = &lockedHead; *pp != NULL && (*pp)->data < key; pp = &(*pp)->next);
+    if(op == 0) r = *pp != NULL && (*pp)->data == key;
+    else if(op == 1 && (*pp == NULL || (*pp)->data != key)) {
+        n = (struct Node*)malloc(sizeof(struct Node));
+        n->data = key; n->next = *pp; *pp = n; r = 1;
+    } else if(op == 2 && *pp != NULL && (*pp)->data == key) {
+        n = *pp; *pp = n->next; free(n); r = 1;
+    }
+    pthread_mutex_unlock(&listLock);
+    return r;
+}
+
+// Worker threads for stress test and benchmark
+#define KEY_RANGE 1024
+
+struct Work {
+    int tid, locked;
+    unsigned seed;
+    long ops;
+    int count[KEY_RANGE];   // successful inserts minus deletes per key
+};
+
+_Atomic int stopFlag;
+long stressOps;
+
+unsigned nextRand(unsigned *s) {
+    *s ^= *s << 13; *s ^= *s >> 17; *s ^= *s << 5;
+    return *s;
+}
+
+void *stressWorker(void *arg) {
+    struct Work *w = (struct Work*)arg;
+    long i;
+    int key, op;
+    for(i = 0; i < stressOps; i++) {
+        key = nextRand(&w->seed) % KEY_RANGE;
+        op = nextRand(&w->seed) % 3;
+        if(op == 0) listContains(w->tid, key);
+        else if(op == 1) w->count[key] += listInsert(w->tid, key);
+        else w->count[key] -= listDelete(w->tid, key);
+    }
+    return NULL;
+}
+
+void *benchWorker(void *arg) {
+    struct Work *w = (struct Work*)arg;
+    unsigned r;
+    int key, op;
+    while(!atomic_load_explicit(&stopFlag, memory_order_relaxed)) {
+        r = nextRand(&w->seed);
+        key = r % KEY_RANGE;
+        op = (r >> 16) % 10 < 8 ? 0 : (r >> 16) % 2 + 1;   // 80% contains
+        if(w->locked) lockedOp(op, key);
+        else if(op == 0) listContains(w->tid, key);
+        else if(op == 1) listInsert(w->tid, key);
+        else listDelete(w->tid, key);
+        w->ops++;
+    }
+    return NULL;
+}
+
+void stressTest(int threads, long ops) {
+    pthread_t th[MAX_THREADS];
+    struct Work *w = (struct Work*)calloc(threads, sizeof(struct Work));
+    struct LNode *cur;
+    int i, k, total, ok = 1, last = INT_MIN;
+    clearList();
+    stressOps = ops;
+    for(i = 0; i < threads; i++) { w[i].tid = i + 1; w[i].seed = 12345 + i * 7919; }
+    for(i = 0; i < threads; i++) pthread_create(&th[i], NULL, stressWorker, &w[i]);
+    for(i = 0; i < threads; i++) pthread_join(th[i], NULL);
+
+    for(k = 0; k < KEY_RANGE; k++) {
+        for(total = 0, i = 0; i < threads; i++) total += w[i].count[k];
+        if(total != listContains(0, k)) { ok = 0; printf("Key %d: net inserts %d, present %d\n", k, total, listContains(0, k)); }
+    }
+    for(cur = PTR(atomic_load(&head.next)); cur != NULL; cur = PTR(atomic_load(&cur->next))) {
+        if(cur->key <= last) { ok = 0; printf("List not strictly sorted at %d\n", cur->key); }
+        last = cur->key;
+    }
+    printf("Stress test with %d threads: %s\n", threads, ok ? "PASSED" : "FAILED");
+    free(w);
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void benchmark(int maxThreads, double seconds) {
+    pthread_t th[MAX_THREADS];
+    struct Work *w = (struct Work*)calloc(maxThreads, sizeof(struct Work));
+    int threads, i, locked;
+    long total;
+    double t;
+    struct timespec pause;
+    printf("Threads   Lock-free Mops/s   Mutex Mops/s\n");
+    for(threads = 1; threads <= maxThreads; threads *= 2) {
+        printf("%7d", threads);
+        for(locked = 0; locked <= 1; locked++) {
+            clearList();
+            for(i = 0; i < KEY_RANGE / 2; i++) { listInsert(0, i * 2); lockedOp(1, i * 2); }
+            for(i = 0; i < threads; i++) { w[i].tid = i + 1; w[i].locked = locked; w[i].seed = 777 + i; w[i].ops = 0; }
+            atomic_store(&stopFlag, 0);
+            t = now();
+            for(i = 0; i < threads; i++) pthread_create(&th[i], NULL, benchWorker, &w[i]);
+            pause.tv_sec = (time_t)seconds;
+            pause.tv_nsec = (long)((seconds - pause.tv_sec) * 1e9);
+            nanosleep(&pause, NULL);
+            atomic_store(&stopFlag, 1);
+            for(i = 0; i < threads; i++) pthread_join(th[i], NULL);
+            t = now() - t;
+            for(total = 0, i = 0; i < threads; i++) total += w[i].ops;
+            printf("%19.2f", total / t / 1e6);
+            while(lockedHead != NULL) lockedOp(2, lockedHead->data);
+        }
+        printf("\n");
+    }
+    clearList();
+    free(w);
+}
+
+void main() {
+    int choice, val, threads;
+    long ops;
+    clrscr();
+    do {
+        printf("\n===== Lock-free Sorted List Menu =====\n");
+        printf("1. Insert\n2. Delete\n3. Contains\n4. Display\n5. Stress Test\n6. Benchmark 1-64 threads\n7. Exit\n");
+        printf("Enter your choice: ");
+        scanf("%d",&choice);
+        switch(choice) {
+            case 1: printf("Enter value: "); scanf("%d",&val);
+                if(listInsert(0, val)) printf("Inserted %d\n", val); else printf("Element %d already present\n", val);
+                break;
+            case 2: printf("Enter value to delete: "); scanf("%d",&val);
+                if(listDelete(0, val)) printf("Deleted %d\n", val); else printf("Element %d not found\n", val);
+                break;
+            case 3: printf("Enter value to search: "); scanf("%d",&val);
+                printf("Element %d %s\n", val, listContains(0, val) ? "found" : "not found");
+                break;
+            case 4: display(); break;
+            case 5:
+                printf("Enter threads (1-64) and operations per thread: "); scanf("%d %ld",&threads,&ops);
+                if(threads < 1 || threads > MAX_THREADS - 1) printf("Invalid thread count\n");
+                else stressTest(threads, ops);
+                break;
+            case 6: benchmark(MAX_THREADS - 1, 0.5); break;
+            case 7: break;
+            default: printf("Invalid choice\n");
+        }
+    } while(choice != 7);
+    clearList();
+    getch();
+}
@@ -1,59 +1,125 @@
 #include <stdio.h>
-#include <conio.h>
-void main() {
-    int A[10][10], B[10][10], C[10][10];
-    int r1,c1,r2,c2,i,j,k;
-    clrscr();
-    
-    // Input first matrix
-    printf("Enter rows and columns of first matrix: ");
-    scanf("%d %d",&r1,&c1);
-    printf("Enter elements of first matrix:\n");
-    for(i=0;i<r1;i++)
-        for(j=0;j<c1;j++)
-            scanf("%d",&A[i][j]);
-    
-    // Input second matrix
-    printf("Enter rows and columns of second matrix: ");
-    scanf("%d %d",&r2,&c2);
-    printf("Enter elements of second matrix:\n");
-    for(i=0;i<r2;i++)
-        for(j=0;j<c2;j++)
-            scanf("%d",&B[i][j]);
+#include <stdlib.h>
+#include "fast_io.h"
+#ifdef BATCH_IO
+#include "dataset.h"
+#endif
+
+// Matrices are stored row-major in one block: element (i,j) of an r x c
+// matrix is at [i*c+j]. Dimensions, counts and indices are size_t so a
+// large matrix's element count cannot overflow int.
+//
+// With -DBATCH_IO the two matrices can also be int32 dataset files (see
+// dataset.h) named on the command line; a row-major file is used straight
+// from the mapping instead of parsed from text:
+//     ./a.out a.ds b.ds > out.txt
+
+// Reads a rows/columns pair; returns 0 on bad input or if r*c ints
+// would not fit in memory at all
+int readDims(size_t *r, size_t *c) {
+    long long a, b;
+    if(!readLong(&a) || !readLong(&b) || a < 0 || b < 0) return 0;
+    *r = (size_t)a; *c = (size_t)b;
+    return *c == 0 || *r <= SIZE_MAX / sizeof(int) / *c;
+}
+
+void operate(const int *A, size_t r1, size_t c1, const int *B, size_t r2, size_t c2) {
+    size_t i,j,k;
+    int sum;
     
     // Addition
     if(r1==r2 && c1==c2){
-        printf("Sum of matrices:\n");
+        writeStr("Sum of matrices:\n");
         for(i=0;i<r1;i++){
             for(j=0;j<c1;j++){
-                C[i][j]=A[i][j]+B[i][j];
-                printf("%d ",C[i][j]);
+                writeInt(A[i*c1+j]+B[i*c1+j]);
+                writeChar(' ');
             }
-            printf("\n");
+            writeChar('\n');
         }
-    } else printf("Addition not possible (dimensions mismatch)\n");
+    } else writeStr("Addition not possible (dimensions mismatch)\n");
     
-    // Multiplication
+    // Multiplication, each entry is written out as soon as it is summed
     if(c1==r2){
-        printf("Product of matrices:\n");
+        writeStr("Product of matrices:\n");
         for(i=0;i<r1;i++){
             for(j=0;j<c2;j++){
-                C[i][j]=0;
+                sum=0;
                 for(k=0;k<c1;k++)
-                    C[i][j]+=A[i][k]*B[k][j];
-                printf("%d ",C[i][j]);
+                    sum+=A[i*c1+k]*B[k*c2+j];
+                writeInt(sum);
+                writeChar(' ');
             }
-            printf("\n");
+            writeChar('\n');
         }
-    } else printf("Multiplication not possible (dimensions mismatch)\n");
+    } else writeStr("Multiplication not possible (dimensions mismatch)\n");
     
     // Transpose of first matrix
-    printf("Transpose of first matrix:\n");
+    writeStr("Transpose of first matrix:\n");
     for(i=0;i<c1;i++){
-        for(j=0;j<r1;j++)
-            printf("%d ",A[j][i]);
-        printf("\n");
+        for(j=0;j<r1;j++){
+            writeInt(A[j*c1+i]);
+            writeChar(' ');
+        }
+        writeChar('\n');
     }
+}
+
+void fromInput() {
+    int *A, *B;
+    size_t r1,c1,r2,c2;
     
-    getch();
+    // Input first matrix
+    prompt("Enter rows and columns of first matrix: ");
+    if(!readDims(&r1, &c1)) { writeStr("Invalid input\n"); return; }
+    A=(int*)malloc((r1*c1>0 ? r1*c1 : 1)*sizeof(int));
+    if(A==NULL) { writeStr("Out of memory\n"); return; }
+    prompt("Enter elements of first matrix:\n");
+    if(!readInts(A, r1*c1)) { writeStr("Invalid input\n"); free(A); return; }
+    
+    // Input second matrix
+    prompt("Enter rows and columns of second matrix: ");
+    if(!readDims(&r2, &c2)) { writeStr("Invalid input\n"); free(A); return; }
+    B=(int*)malloc((r2*c2>0 ? r2*c2 : 1)*sizeof(int));
+    if(B==NULL) { writeStr("Out of memory\n"); free(A); return; }
+    prompt("Enter elements of second matrix:\n");
+    if(!readInts(B, r2*c2)) { writeStr("Invalid input\n"); free(A); free(B); return; }
+    
+    operate(A, r1, c1, B, r2, c2);
+    free(A); free(B);
+}
+
+#ifdef BATCH_IO
+int openMatrix(const char *file, struct Dataset *ds, const int **a, int **copy) {
+    int rc = datasetOpen(ds, file, 0);
+    if(rc == DS_OK && (rc = datasetInts(ds, a, copy)) != DS_OK) datasetClose(ds);
+    if(rc != DS_OK) { writeStr(file); writeStr(": "); writeStr(datasetError(rc)); writeChar('\n'); return 0; }
+    return 1;
+}
+#endif
+
+void fromDatasets(const char *fileA, const char *fileB) {
+#ifdef BATCH_IO
+    struct Dataset dsA, dsB;
+    const int *A, *B;
+    int *copyA, *copyB;
+    if(!openMatrix(fileA, &dsA, &A, &copyA)) return;
+    if(openMatrix(fileB, &dsB, &B, &copyB)) {
+        operate(A, (size_t)dsA.hdr->dims[0], (size_t)dsA.hdr->dims[1], B, (size_t)dsB.hdr->dims[0], (size_t)dsB.hdr->dims[1]);
+        free(copyB);
+        datasetClose(&dsB);
+    }
+    free(copyA);
+    datasetClose(&dsA);
+#else
+    (void)fileA; (void)fileB;
+    writeStr("Dataset files need a -DBATCH_IO build\n");
+#endif
+}
+
+void main(int argc, char **argv) {
+    startIO();
+    if(argc > 2) fromDatasets(argv[1], argv[2]);
+    else fromInput();
+    endIO();
 }
@@ -1,26 +1,28 @@
 #include <stdio.h>
-#include <conio.h>
+#include "fast_io.h"
 
 void main() {
     int matrix[2][3], i, j;
-    clrscr();
+    startIO();
     
-    printf("Enter 6 elements for 2x3 matrix:\n");
-    for(i=0;i<2;i++)
-        for(j=0;j<3;j++)
-            scanf("%d",&matrix[i][j]);
+    prompt("Enter 6 elements for 2x3 matrix:\n");
+    if(!readInts(&matrix[0][0], 6)) { writeStr("Invalid input\n"); endIO(); return; }
     
     // Row-major
-    printf("Row-major order: ");
+    writeStr("Row-major order: ");
     for(i=0;i<2;i++)
-        for(j=0;j<3;j++)
-            printf("%d ", matrix[i][j]);
+        for(j=0;j<3;j++) {
+            writeInt(matrix[i][j]);
+            writeChar(' ');
+        }
     
     // Column-major
-    printf("\nColumn-major order: ");
+    writeStr("\nColumn-major order: ");
     for(j=0;j<3;j++)
-        for(i=0;i<2;i++)
-            printf("%d ", matrix[i][j]);
+        for(i=0;i<2;i++) {
+            writeInt(matrix[i][j]);
+            writeChar(' ');
+        }
     
-    getch();
+    endIO();
 }
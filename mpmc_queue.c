@@ -0,0 +1,306 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+// Bounded multi-producer/multi-consumer queue (Vyukov). Every cell carries
+// a sequence number: a producer may fill cell pos when seq == pos, and a
+// consumer may empty it when seq == pos + 1, so producers and consumers
+// only contend on their own position counter. Threads that find the queue
+// empty (or full) park on a futex word instead of spinning.
+// Linux only: parking uses the futex system call.
+
+#define CACHE_LINE 64
+#define SPIN_TRIES 16   // retries (each yielding the CPU) before parking
+
+struct Cell {
+    _Atomic size_t seq;
+    int data;
+};
+
+struct Queue {
+    struct Cell *buf;
+    size_t mask;
+    _Alignas(CACHE_LINE) _Atomic size_t enqPos;
+    _Alignas(CACHE_LINE) _Atomic size_t deqPos;
+    _Alignas(CACHE_LINE) _Atomic uint32_t notEmpty;   // futex words, bumped on
+    _Atomic uint32_t notFull;                         // every wake
+    _Atomic int sleepingConsumers, sleepingProducers;
+};
+
+long futexWait(_Atomic uint32_t *addr, uint32_t val, const struct timespec *rel) {
+    return syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, rel, NULL, 0);
+}
+
+void futexWake(_Atomic uint32_t *addr, int n) {
+    syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, n, NULL, NULL, 0);
+}
+
+int queueInit(struct Queue *q, size_t size) {
+    size_t cap = 2, i;
+    while(cap < size) cap <<= 1;
+    q->buf = (struct Cell*)malloc(cap * sizeof(struct Cell));
+    if(q->buf == NULL) return 0;
+    for(i = 0; i < cap; i++) atomic_init(&q->buf[i].seq, i);
+    q->mask = cap - 1;
+    atomic_init(&q->enqPos, 0);
+    atomic_init(&q->deqPos, 0);
+    atomic_init(&q->notEmpty, 0);
+    atomic_init(&q->notFull, 0);
+    atomic_init(&q->sleepingConsumers, 0);
+    atomic_init(&q->sleepingProducers, 0);
+    return 1;
+}
+
+// Wake one sleeper of the other side if there is one
+void wakeOne(_Atomic uint32_t *word, _Atomic int *sleepers) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if(atomic_load_explicit(sleepers, memory_order_relaxed) > 0) {
+        atomic_fetch_add(word, 1);
+        futexWake(word, 1);
+    }
+}
+
+int tryEnqueue(struct Queue *q, int val) {
+    size_t pos = atomic_load_explicit(&q->enqPos, memory_order_relaxed), seq;
+    struct Cell *c;
+    long diff;
+    for(;;) {
+        c = &q->buf[pos & q->mask];
+        seq = atomic_load_explicit(&c->seq, memory_order_acquire);
+        diff = (long)seq - (long)pos;
+        if(diff == 0) {
+            if(atomic_compare_exchange_weak_explicit(&q->enqPos, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed)) break;
+        }
+        else if(diff < 0) return 0;   // full
+        else pos = atomic_load_explicit(&q->enqPos, memory_order_relaxed);
+    }
+    c->data = val;
+    atomic_store_explicit(&c->seq, pos + 1, memory_order_release);
+    wakeOne(&q->notEmpty, &q->sleepingConsumers);
+    return 1;
+}
+
+int tryDequeue(struct Queue *q, int *val) {
+    size_t pos = atomic_load_explicit(&q->deqPos, memory_order_relaxed), seq;
+    struct Cell *c;
+    long diff;
+    for(;;) {
+        c = &q->buf[pos & q->mask];
+        seq = atomic_load_explicit(&c->seq, memory_order_acquire);
+        diff = (long)seq - (long)(pos + 1);
+        if(diff == 0) {
+            if(atomic_compare_exchange_weak_explicit(&q->deqPos, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed)) break;
+        }
+        else if(diff < 0) return 0;   // empty
+        else pos = atomic_load_explicit(&q->deqPos, memory_order_relaxed);
+    }
+    *val = c->data;
+    atomic_store_explicit(&c->seq, pos + q->mask + 1, memory_order_release);
+    wakeOne(&q->notFull, &q->sleepingProducers);
+    return 1;
+}
+
+// Remaining time until deadline, 0 if it has passed
+int remaining(const struct timespec *deadline, struct timespec *rel) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    rel->tv_sec = deadline->tv_sec - now.tv_sec;
+    rel->tv_nsec = deadline->tv_nsec - now.tv_nsec;
+    if(rel->tv_nsec < 0) { rel->tv_sec--; rel->tv_nsec += 1000000000L; }
+    return rel->tv_sec >= 0;
+}
+
+// Shared slow path: spin briefly, then park until woken or timed out.
+// timeoutMs < 0 waits forever. Returns 1 on success, 0 on timeout.
+int waitFor(struct Queue *q, int isEnq, int *val, long timeoutMs) {
+    _Atomic uint32_t *word = isEnq ? &q->notFull : &q->notEmpty;
+    _Atomic int *sleepers = isEnq ? &q->sleepingProducers : &q->sleepingConsumers;
+    struct timespec deadline, rel;
+    uint32_t w;
+    int i, ok;
+    for(i = 0; i < SPIN_TRIES; i++) {
+        if(isEnq ? tryEnqueue(q, *val) : tryDequeue(q, val)) return 1;
+        sched_yield();
+    }
+    if(timeoutMs >= 0) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeoutMs / 1000;
+        deadline.tv_nsec += (timeoutMs % 1000) * 1000000L;
+        if(deadline.tv_nsec >= 1000000000L) { deadline.tv_sec++; deadline.tv_nsec -= 1000000000L; }
+    }
+    for(;;) {
+        w = atomic_load(word);
+        atomic_fetch_add(sleepers, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        ok = isEnq ? tryEnqueue(q, *val) : tryDequeue(q, val);   // recheck after announcing
+        if(!ok) {
+            if(timeoutMs < 0) futexWait(word, w, NULL);
+            else if(remaining(&deadline, &rel)) futexWait(word, w, &rel);
+            else { atomic_fetch_sub(sleepers, 1); return 0; }
+        }
+        atomic_fetch_sub(sleepers, 1);
+        if(ok) return 1;
+    }
+}
+
+void enqueue(struct Queue *q, int val) { waitFor(q, 1, &val, -1); }
+int dequeue(struct Queue *q) { int v; waitFor(q, 0, &v, -1); return v; }
+int timedEnqueue(struct Queue *q, int val, long ms) { return waitFor(q, 1, &val, ms); }
+int timedDequeue(struct Queue *q, int *val, long ms) { return waitFor(q, 0, val, ms); }
+
+// Only safe while no other thread uses the queue
+void display(struct Queue *q) {
+    size_t i, head = atomic_load(&q->deqPos), tail = atomic_load(&q->enqPos);
+    if(head == tail) { printf("Queue is empty"); return; }
+    printf("Queue elements: ");
+    for(i = head; i != tail; i++) printf("%d ", q->buf[i & q->mask].data);
+}
+
+// Baseline: ring buffer behind one mutex and two condition variables
+struct LockedQueue {
+    int *buf;
+    int size, front, count;
+    pthread_mutex_t lock;
+    pthread_cond_t notEmpty, notFull;
+};
+
+void lockedInit(struct LockedQueue *q, int size) {
+    q->buf = (int*)malloc(size * sizeof(int));
+    q->size = size; q->front = q->count = 0;
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->notEmpty, NULL);
+    pthread_cond_init(&q->notFull, NULL);
+}
+
+void lockedEnqueue(struct LockedQueue *q, int val) {
+    pthread_mutex_lock(&q->lock);
+    while(q->count == q->size) pthread_cond_wait(&q->notFull, &q->lock);
+    q->buf[(q->front + q->count++) % q->size] = val;
+    pthread_cond_signal(&q->notEmpty);
+    pthread_mutex_unlock(&q->lock);
+}
+
+int lockedDequeue(struct LockedQueue *q) {
+    int v;
+    pthread_mutex_lock(&q->lock);
+    while(q->count == 0) pthread_cond_wait(&q->notEmpty, &q->lock);
+    v = q->buf[q->front];
+    q->front = (q->front + 1) % q->size;
+    q->count--;
+    pthread_cond_signal(&q->notFull);
+    pthread_mutex_unlock(&q->lock);
+    return v;
+}
+
+// Contention benchmark: P producers send items 1..n between them,
+// C consumers take n items between them and sum them
+#define MAX_THREADS 64
+
+struct Bench {
+    struct Queue q;
+    struct LockedQueue lq;
+    int locked, producers, consumers;
+    long n;
+    _Atomic long long sum;
+};
+
+struct Worker {
+    struct Bench *b;
+    int id;
+};
+
+void *producer(void *arg) {
+    struct Worker *w = (struct Worker*)arg;
+    struct Bench *b = w->b;
+    long i;
+    for(i = w->id + 1; i <= b->n; i += b->producers)
+        if(b->locked) lockedEnqueue(&b->lq, (int)i);
+        else enqueue(&b->q, (int)i);
+    return NULL;
+}
+
+void *consumer(void *arg) {
+    struct Worker *w = (struct Worker*)arg;
+    struct Bench *b = w->b;
+    long i, share = b->n / b->consumers + (w->id < b->n % b->consumers);
+    long long sum = 0;
+    for(i = 0; i < share; i++)
+        sum += b->locked ? lockedDequeue(&b->lq) : dequeue(&b->q);
+    atomic_fetch_add(&b->sum, sum);
+    return NULL;
+}
+
+void benchmark(int producers, int consumers, long n) {
+    struct Bench b;
+    struct Worker pw[MAX_THREADS], cw[MAX_THREADS];
+    pthread_t pt[MAX_THREADS], ct[MAX_THREADS];
+    struct timespec t0, t1;
+    double secs;
+    int i;
+    queueInit(&b.q, 1024);
+    lockedInit(&b.lq, 1024);
+    b.producers = producers; b.consumers = consumers; b.n = n;
+    for(b.locked = 0; b.locked <= 1; b.locked++) {
+        atomic_store(&b.sum, 0);
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for(i = 0; i < consumers; i++) { cw[i].b = &b; cw[i].id = i; pthread_create(&ct[i], NULL, consumer, &cw[i]); }
+        for(i = 0; i < producers; i++) { pw[i].b = &b; pw[i].id = i; pthread_create(&pt[i], NULL, producer, &pw[i]); }
+        for(i = 0; i < producers; i++) pthread_join(pt[i], NULL);
+        for(i = 0; i < consumers; i++) pthread_join(ct[i], NULL);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9;
+        printf("%-16s %dP/%dC: %.3f s, %.2f M items/s, %s\n", b.locked ? "Mutex+condvar" : "Vyukov MPMC",
+               producers, consumers, secs, n / secs / 1e6,
+               atomic_load(&b.sum) == (long long)n * (n + 1) / 2 ? "sum OK" : "SUM ERROR");
+    }
+    free(b.q.buf);
+    free(b.lq.buf);
+}
+
+int main() {
+    struct Queue q;
+    int choice, val, p, c;
+    long n, ms;
+    if(!queueInit(&q, 8)) { printf("Queue Overflow"); return 1; }
+    do {
+        printf("\n1.Enqueue 2.Dequeue 3.Timed Dequeue 4.Display 5.Benchmark 6.Exit\nEnter choice: ");
+        scanf("%d",&choice);
+        switch(choice) {
+            case 1:
+                printf("Enter value to enqueue: ");
+                scanf("%d",&val);
+                if(!tryEnqueue(&q, val)) printf("Queue Overflow");
+                break;
+            case 2:
+                if(tryDequeue(&q, &val)) printf("Dequeued element: %d", val);
+                else printf("Queue Underflow");
+                break;
+            case 3:
+                printf("Enter timeout in ms: ");
+                scanf("%ld",&ms);
+                if(timedDequeue(&q, &val, ms)) printf("Dequeued element: %d", val);
+                else printf("Timed out, queue is empty");
+                break;
+            case 4: display(&q); break;
+            case 5:
+                printf("Enter producers, consumers (1-64) and items: ");
+                scanf("%d %d %ld",&p,&c,&n);
+                if(p < 1 || c < 1 || p > MAX_THREADS || c > MAX_THREADS || n < 1) printf("Invalid input");
+                else benchmark(p, c, n);
+                break;
+            case 6: break;
+            default: printf("Invalid choice");
+        }
+    } while(choice!=6);
+    free(q.buf);
+    return 0;
+}
@@ -0,0 +1,290 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+// Relaxed concurrent priority queue (MultiQueue). The queue is c * threads
+// ordinary binary heaps, each behind its own try-lock. Enqueue locks a
+// random heap; dequeue peeks at two random heaps and takes from the one
+// whose top has the higher priority. Dequeues are not exactly in priority
+// order, but the expected rank error is O(c * threads) and there is no
+// single lock for all threads to fight over.
+
+#define MAX_THREADS 64
+#define CACHE_LINE 64
+
+struct Item {
+    int data;
+    int priority;
+};
+
+struct Heap {
+    _Alignas(CACHE_LINE) atomic_flag lock;
+    _Atomic int top;        // priority of the top element, INT_MIN if empty
+    struct Item *items;
+    int size, capacity;
+};
+
+struct Heap *heaps;
+int nHeaps;
+
+void heapPush(struct Heap *h, struct Item it) {
+    int i, p;
+    if(h->size == h->capacity) {
+        h->capacity = h->capacity ? h->capacity * 2 : 64;
+        h->items = (struct Item*)realloc(h->items, h->capacity * sizeof(struct Item));
+        if(h->items == NULL) { printf("\nPriority Queue Overflow"); exit(1); }
+    }
+    for(i = h->size++; i > 0; i = p) {
+        p = (i - 1) / 2;
+        if(h->items[p].priority >= it.priority) break;
+        h->items[i] = h->items[p];
+    }
+    h->items[i] = it;
+}
+
+struct Item heapPop(struct Heap *h) {
+    struct Item top = h->items[0], last = h->items[--h->size];
+    int i = 0, c;
+    for(;;) {
+        c = 2 * i + 1;
+        if(c >= h->size) break;
+        if(c + 1 < h->size && h->items[c + 1].priority > h->items[c].priority) c++;
+        if(h->items[c].priority <= last.priority) break;
+        h->items[i] = h->items[c];
+        i = c;
+    }
+    if(h->size > 0) h->items[i] = last;
+    return top;
+}
+
+void publishTop(struct Heap *h) {
+    atomic_store_explicit(&h->top, h->size ? h->items[0].priority : INT_MIN, memory_order_relaxed);
+}
+
+int tryLock(struct Heap *h) {
+    return !atomic_flag_test_and_set_explicit(&h->lock, memory_order_acquire);
+}
+
+void unlock(struct Heap *h) {
+    atomic_flag_clear_explicit(&h->lock, memory_order_release);
+}
+
+void multiQueueInit(int threads, int c) {
+    int i;
+    nHeaps = threads * c < 2 ? 2 : threads * c;
+    heaps = (struct Heap*)aligned_alloc(CACHE_LINE, nHeaps * sizeof(struct Heap));
+    for(i = 0; i < nHeaps; i++) {
+        atomic_flag_clear(&heaps[i].lock);
+        atomic_init(&heaps[i].top, INT_MIN);
+        heaps[i].items = NULL;
+        heaps[i].size = heaps[i].capacity = 0;
+    }
+}
+
+void multiQueueFree() {
+    int i;
+    for(i = 0; i < nHeaps; i++) free(heaps[i].items);
+    free(heaps);
+}
+
+unsigned nextRand(unsigned *s) {
+    *s ^= *s << 13; *s ^= *s >> 17; *s ^= *s << 5;
+    return *s;
+}
+
+void enqueue(int data, int priority, unsigned *seed) {
+    struct Heap *h;
+    struct Item it;
+    it.data = data;
+    it.priority = priority;
+    do h = &heaps[nextRand(seed) % nHeaps]; while(!tryLock(h));
+    heapPush(h, it);
+    publishTop(h);
+    unlock(h);
+}
+
+// Returns 0 only after a full scan found every heap empty
+int dequeue(struct Item *out, unsigned *seed) {
+    struct Heap *a, *b, *h;
+    int i, ta, tb;
+    for(;;) {
+        a = &heaps[nextRand(seed) % nHeaps];
+        b = &heaps[nextRand(seed) % nHeaps];
+        ta = atomic_load_explicit(&a->top, memory_order_relaxed);
+        tb = atomic_load_explicit(&b->top, memory_order_relaxed);
+        h = tb > ta ? b : a;
+        if((ta > tb ? ta : tb) == INT_MIN) {   // both look empty: check all
+            for(i = 0; i < nHeaps; i++)
+                if(atomic_load_explicit(&heaps[i].top, memory_order_relaxed) != INT_MIN) break;
+            if(i == nHeaps) return 0;
+            continue;
+        }
+        if(!tryLock(h)) continue;
+        if(h->size == 0) { unlock(h); continue; }
+        *out = heapPop(h);
+        publishTop(h);
+        unlock(h);
+        return 1;
+    }
+}
+
+// ---------- Rank error measurement ----------
+//
+// Single-threaded: fill the queue with distinct priorities, then for every
+// dequeue record how many still-queued elements had a higher priority
+// (the rank error; 0 for an exact priority queue). A Fenwick tree over the
+// priorities answers "how many queued elements are above p" in O(log n).
+
+long *fenwick;
+int fenN;
+
+void fenAdd(int i, long v) { for(i++; i <= fenN; i += i & -i) fenwick[i] += v; }
+long fenSum(int i) { long s = 0; for(i++; i > 0; i -= i & -i) s += fenwick[i]; return s; }
+
+void rankError(int n, int threads, int c) {
+    unsigned seed = 12345;
+    struct Item it;
+    long total = 0, worst = 0, err;
+    int i, j, k, *perm = (int*)malloc(n * sizeof(int));
+    fenN = n;
+    fenwick = (long*)calloc(n + 1, sizeof(long));
+    multiQueueInit(threads, c);
+    for(i = 0; i < n; i++) perm[i] = i;
+    for(i = n - 1; i > 0; i--) { j = nextRand(&seed) % (i + 1); k = perm[i]; perm[i] = perm[j]; perm[j] = k; }
+    for(i = 0; i < n; i++) { enqueue(i, perm[i], &seed); fenAdd(perm[i], 1); }
+    for(i = 0; i < n; i++) {
+        dequeue(&it, &seed);
+        err = fenSum(n - 1) - fenSum(it.priority);   // queued with higher priority
+        total += err;
+        if(err > worst) worst = err;
+        fenAdd(it.priority, -1);
+    }
+    printf("\n%d heaps (c=%d, %d threads): mean rank error %.2f, max %ld",
+           nHeaps, c, threads, (double)total / n, worst);
+    multiQueueFree();
+    free(fenwick);
+    free(perm);
+}
+
+// ---------- Throughput benchmark ----------
+
+struct Work {
+    unsigned seed;
+    long ops;
+    int locked;
+};
+
+_Atomic int stopFlag;
+struct Heap globalHeap;   // baseline: one heap behind one lock
+pthread_mutex_t globalLock = PTHREAD_MUTEX_INITIALIZER;
+
+void *worker(void *arg) {
+    struct Work *w = (struct Work*)arg;
+    struct Item it;
+    while(!atomic_load_explicit(&stopFlag, memory_order_relaxed)) {
+        it.data = 0;
+        it.priority = nextRand(&w->seed) % 1000000;
+        if(w->locked) {
+            pthread_mutex_lock(&globalLock);
+            heapPush(&globalHeap, it);
+            if(globalHeap.size) heapPop(&globalHeap);
+            pthread_mutex_unlock(&globalLock);
+        } else {
+            enqueue(it.data, it.priority, &w->seed);
+            dequeue(&it, &w->seed);
+        }
+        w->ops += 2;
+    }
+    return NULL;
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void benchmark(int c, int prefill) {
+    pthread_t th[MAX_THREADS];
+    struct Work w[MAX_THREADS];
+    struct timespec pause = { 0, 500000000L };
+    struct Item it;
+    int threads, mode, i;
+    unsigned seed = 7;
+    long total;
+    double t;
+    printf("\nThreads   MultiQueue   Global lock   (Mops/s)");
+    for(threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        printf("\n%7d", threads);
+        for(mode = 0; mode <= 1; mode++) {
+            multiQueueInit(threads, c);
+            globalHeap.items = NULL; globalHeap.size = globalHeap.capacity = 0;
+            for(i = 0; i < prefill; i++) {
+                it.data = 0; it.priority = nextRand(&seed) % 1000000;
+                if(mode) heapPush(&globalHeap, it); else enqueue(0, it.priority, &seed);
+            }
+            atomic_store(&stopFlag, 0);
+            for(i = 0; i < threads; i++) { w[i].seed = 1 + i * 7919; w[i].ops = 0; w[i].locked = mode; }
+            t = now();
+            for(i = 0; i < threads; i++) pthread_create(&th[i], NULL, worker, &w[i]);
+            nanosleep(&pause, NULL);
+            atomic_store(&stopFlag, 1);
+            for(i = 0; i < threads; i++) pthread_join(th[i], NULL);
+            t = now() - t;
+            for(total = 0, i = 0; i < threads; i++) total += w[i].ops;
+            printf("%13.2f", total / t / 1e6);
+            multiQueueFree();
+            free(globalHeap.items);
+        }
+    }
+}
+
+void main() {
+    int choice, data, priority, threads, c, n;
+    unsigned seed = 1;
+    struct Item it;
+    clrscr();
+    multiQueueInit(1, 2);
+    do {
+        printf("\n1.Enqueue 2.Dequeue 3.Rank Error (clears queue) 4.Benchmark (clears queue) 5.Exit\nEnter choice: ");
+        scanf("%d",&choice);
+        switch(choice) {
+            case 1:
+                printf("Enter data and priority: "); scanf("%d %d",&data,&priority);
+                if(priority == INT_MIN) priority++;   // INT_MIN marks an empty heap
+                enqueue(data, priority, &seed);
+                printf("\n%d enqueued with priority %d", data, priority);
+                break;
+            case 2:
+                if(dequeue(&it, &seed)) printf("\n%d dequeued (Priority: %d)", it.data, it.priority);
+                else printf("\nPriority Queue is Empty!");
+                break;
+            case 3:
+                printf("Enter elements, threads and c: "); scanf("%d %d %d",&n,&threads,&c);
+                if(n > 0 && threads > 0 && c > 0) {
+                    multiQueueFree();
+                    rankError(n, threads, c);
+                    multiQueueInit(1, 2);
+                }
+                else printf("\nInvalid input");
+                break;
+            case 4:
+                printf("Enter c and prefill size: "); scanf("%d %d",&c,&n);
+                if(c > 0 && n >= 0) {
+                    multiQueueFree();
+                    benchmark(c, n);
+                    multiQueueInit(1, 2);
+                }
+                else printf("\nInvalid input");
+                break;
+            case 5: break;
+            default: printf("Invalid choice");
+        }
+    } while(choice!=5);
+    multiQueueFree();
+    getch();
+}
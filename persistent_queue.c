@@ -0,0 +1,253 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Durable FIFO queue of ints on local disk (POSIX: uses mmap/msync).
+//
+// Elements are appended to fixed-size segment files that are memory
+// mapped, so enqueue and dequeue are plain memory accesses. Element number
+// seq lives in segment seq / SLOTS, slot seq % SLOTS. Each slot stores
+// seq + 1 next to the value, so a slot can be told apart from stale data
+// left by an earlier use of a recycled segment file.
+//
+// A small checkpoint file holds the durable write position and the
+// consumer's acknowledged read position. Enqueues are made durable in
+// groups (one msync for up to GROUP elements). Recovery reads the
+// checkpoint and scans forward at most the unsynced tail, so it does not
+// depend on the queue length. Fully consumed segment files are renamed
+// and reused for new segments instead of being deleted and recreated.
+
+#define SLOTS    (128 * 1024)          // slots per segment (1 MiB files)
+#define SEG_BYTES ((size_t)SLOTS * sizeof(struct Slot))
+#define GROUP    256                   // enqueues per group commit
+#define MAGIC    0x5155455545554531ULL
+
+struct Slot {
+    uint32_t tag;      // (uint32)(seq + 1) once written
+    int32_t value;
+};
+
+struct Checkpoint {
+    uint64_t magic;
+    uint64_t writeSeq;    // elements [0, writeSeq) are durable
+    uint64_t readSeq;     // elements [0, readSeq) are consumed
+};
+
+struct Queue {
+    char dir[256];
+    struct Checkpoint *cp;          // mapped checkpoint file
+    uint64_t writeSeq, readSeq;     // in-memory positions
+    struct Slot *wseg, *rseg;       // mapped write and read segments
+    uint64_t wsegNo, rsegNo;
+    uint64_t syncedSeq;             // first element not yet msynced
+    uint64_t recycleFrom;           // lowest segment that may still be on disk
+    long fsyncs;
+};
+
+void segPath(struct Queue *q, uint64_t no, char *path) {
+    sprintf(path, "%s/seg_%010llu.dat", q->dir, (unsigned long long)no);
+}
+
+// Map segment no, creating it (or recycling a consumed one) if missing
+struct Slot *mapSegment(struct Queue *q, uint64_t no) {
+    char path[300], old[300];
+    uint64_t s;
+    void *p;
+    int fd;
+    segPath(q, no, path);
+    fd = open(path, O_RDWR);
+    if(fd < 0) {
+        for(s = q->recycleFrom; s < q->readSeq / SLOTS; s++) {   // fully consumed segments
+            segPath(q, s, old);
+            if(rename(old, path) == 0) { s++; break; }
+        }
+        q->recycleFrom = s;
+        fd = open(path, O_RDWR | O_CREAT, 0644);
+        if(fd < 0 || ftruncate(fd, SEG_BYTES) != 0) { perror("segment"); exit(1); }
+    }
+    p = mmap(NULL, SEG_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(p == MAP_FAILED) { perror("mmap"); exit(1); }
+    return (struct Slot*)p;
+}
+
+struct Slot *slotFor(struct Queue *q, uint64_t seq, int forWrite) {
+    uint64_t no = seq / SLOTS;
+    if(forWrite) {
+        if(q->wseg == NULL || q->wsegNo != no) {
+            if(q->wseg) munmap(q->wseg, SEG_BYTES);
+            q->wseg = mapSegment(q, no);
+            q->wsegNo = no;
+        }
+        return &q->wseg[seq % SLOTS];
+    }
+    if(q->rseg == NULL || q->rsegNo != no) {
+        if(q->rseg) munmap(q->rseg, SEG_BYTES);
+        q->rseg = mapSegment(q, no);
+        q->rsegNo = no;
+    }
+    return &q->rseg[seq % SLOTS];
+}
+
+void syncCheckpoint(struct Queue *q) {
+    msync(q->cp, sizeof(struct Checkpoint), MS_SYNC);
+    q->fsyncs++;
+}
+
+// Group commit: flush every slot written since the last commit, then
+// publish the new durable write position
+void commit(struct Queue *q) {
+    uint64_t seq = q->syncedSeq, end;
+    long page = sysconf(_SC_PAGESIZE);
+    uintptr_t from, to;
+    struct Slot *base;
+    while(seq < q->writeSeq) {
+        end = (seq / SLOTS + 1) * SLOTS;
+        if(end > q->writeSeq) end = q->writeSeq;
+        base = slotFor(q, seq, 1);
+        from = (uintptr_t)base & ~(uintptr_t)(page - 1);
+        to = (uintptr_t)(base + (end - seq));
+        msync((void*)from, to - from, MS_SYNC);
+        q->fsyncs++;
+        seq = end;
+    }
+    q->syncedSeq = q->writeSeq;
+    if(q->cp->writeSeq != q->writeSeq || q->cp->readSeq != q->readSeq) {
+        q->cp->writeSeq = q->writeSeq;
+        q->cp->readSeq = q->readSeq;
+        syncCheckpoint(q);
+    }
+}
+
+double nowMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec * 1e-6;
+}
+
+void queueOpen(struct Queue *q, const char *dir) {
+    char path[300];
+    double t = nowMs();
+    struct Slot *s;
+    long recovered = 0;
+    int fd;
+    memset(q, 0, sizeof(*q));
+    strncpy(q->dir, dir, sizeof(q->dir) - 1);
+    mkdir(dir, 0755);
+    sprintf(path, "%s/checkpoint.dat", dir);
+    fd = open(path, O_RDWR | O_CREAT, 0644);
+    if(fd < 0 || ftruncate(fd, sizeof(struct Checkpoint)) != 0) { perror("checkpoint"); exit(1); }
+    q->cp = (struct Checkpoint*)mmap(NULL, sizeof(struct Checkpoint), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(q->cp == MAP_FAILED) { perror("mmap"); exit(1); }
+    if(q->cp->magic != MAGIC) {   // new queue
+        q->cp->magic = MAGIC;
+        q->cp->writeSeq = q->cp->readSeq = 0;
+        syncCheckpoint(q);
+    }
+    q->writeSeq = q->cp->writeSeq;
+    q->readSeq = q->cp->readSeq;
+    // Pick up elements that reached disk after the last checkpoint
+    for(;;) {
+        s = slotFor(q, q->writeSeq, 1);
+        if(s->tag != (uint32_t)(q->writeSeq + 1)) break;
+        q->writeSeq++;
+        recovered++;
+    }
+    q->syncedSeq = q->writeSeq;
+    commit(q);
+    printf("Opened queue in %s in %.2f ms: %llu pending, %ld recovered past checkpoint\n", dir, nowMs() - t,
+           (unsigned long long)(q->writeSeq - q->readSeq), recovered);
+}
+
+void enqueue(struct Queue *q, int val) {
+    struct Slot *s = slotFor(q, q->writeSeq, 1);
+    s->value = val;
+    s->tag = (uint32_t)(q->writeSeq + 1);
+    q->writeSeq++;
+    if(q->writeSeq - q->syncedSeq >= GROUP) commit(q);
+}
+
+// Only durable elements are handed out, so a crash can never make the
+// consumer position run ahead of the data
+int dequeue(struct Queue *q, int *val) {
+    if(q->readSeq == q->syncedSeq) {
+        if(q->syncedSeq == q->writeSeq) return 0;
+        commit(q);
+    }
+    *val = slotFor(q, q->readSeq, 0)->value;
+    q->readSeq++;
+    if(q->readSeq % GROUP == 0) commit(q);   // checkpoint the consumer in groups too
+    return 1;
+}
+
+void queueClose(struct Queue *q) {
+    commit(q);
+    if(q->wseg) munmap(q->wseg, SEG_BYTES);
+    if(q->rseg) munmap(q->rseg, SEG_BYTES);
+    munmap(q->cp, sizeof(struct Checkpoint));
+}
+
+void display(struct Queue *q) {
+    uint64_t i;
+    if(q->readSeq == q->writeSeq) { printf("Queue is empty"); return; }
+    printf("Queue elements: ");
+    for(i = q->readSeq; i < q->writeSeq && i < q->readSeq + 50; i++) printf("%d ", slotFor(q, i, 1)->value);
+    if(q->writeSeq - q->readSeq > 50) printf("... (%llu total)", (unsigned long long)(q->writeSeq - q->readSeq));
+}
+
+void benchmark(struct Queue *q, long n) {
+    long i, fs = q->fsyncs;
+    int v, ok = 1;
+    double t = nowMs();
+    for(i = 0; i < n; i++) enqueue(q, (int)i);
+    commit(q);
+    printf("%ld enqueues: %.1f ms, %ld syncs\n", n, nowMs() - t, q->fsyncs - fs);
+    // drain anything queued before the benchmark
+    while(q->writeSeq - q->readSeq > (uint64_t)n) dequeue(q, &v);
+    t = nowMs();
+    fs = q->fsyncs;
+    for(i = 0; i < n; i++) if(!dequeue(q, &v) || v != (int)i) ok = 0;
+    commit(q);
+    printf("%ld dequeues: %.1f ms, %ld syncs, %s\n", n, nowMs() - t, q->fsyncs - fs, ok ? "order OK" : "ORDER ERROR");
+}
+
+int main(int argc, char **argv) {
+    struct Queue q;
+    int choice, val;
+    long n;
+    queueOpen(&q, argc > 1 ? argv[1] : "queue_data");
+    do {
+        printf("\n1.Enqueue 2.Dequeue 3.Commit 4.Display 5.Benchmark 6.Simulate Crash 7.Exit\nEnter choice: ");
+        if(scanf("%d",&choice) != 1) choice = 7;
+        switch(choice) {
+            case 1:
+                printf("Enter value to enqueue: ");
+                scanf("%d",&val);
+                enqueue(&q, val);
+                break;
+            case 2:
+                if(dequeue(&q, &val)) printf("Dequeued element: %d", val);
+                else printf("Queue Underflow");
+                break;
+            case 3: commit(&q); printf("Committed"); break;
+            case 4: display(&q); break;
+            case 5:
+                printf("Enter number of elements: ");
+                scanf("%ld",&n);
+                if(n > 0) benchmark(&q, n);
+                break;
+            case 6: _exit(1);   // no commit: recovery runs on next start
+            case 7: break;
+            default: printf("Invalid choice");
+        }
+    } while(choice!=7);
+    queueClose(&q);
+    return 0;
+}
@@ -0,0 +1,376 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include "bytecode.h"
+
+// Columnar evaluation of a postfix program over many rows.
+//
+// The program is the bytecode produced by infix_compiler.c (see
+// bytecode.h). Here it is loaded from its printed form, e.g. "a b + 2 ^ ~"
+// where ~ is unary minus. Variable k of the program reads column k.
+//
+// evaluatePostfix() in postfix.c decodes every character of every row.
+// This evaluator instead runs the stack machine over blocks of BLOCK rows:
+// each stack slot is a whole block, and each opcode is one tight loop
+// over that block, which the compiler turns into SIMD code. Decoding and
+// dispatch happen once per opcode per block, not once per row.
+//
+// Values are either int64 or double. Integer +, -, *, ^ wrap around on
+// overflow; division by zero (and INT64_MIN / -1) stops the evaluation
+// and reports the row, in both modes.
+
+#define BLOCK 256
+#define MAX_VARS 26
+
+typedef long long i64;
+typedef unsigned long long u64;
+
+struct Program {
+    long long *code;
+    int len, maxDepth;
+    char *names[MAX_VARS];
+    int nVars;
+};
+
+// ---------- Loading ----------
+
+int varIndex(struct Program *p, const char *name, int len) {
+    int i;
+    for (i = 0; i < p->nVars; i++) if (strncmp(p->names[i], name, len) == 0 && p->names[i][len] == '\0') return i;
+    if (p->nVars == MAX_VARS || (p->names[i] = (char*)malloc(len + 1)) == NULL) return -1;
+    memcpy(p->names[i], name, len);
+    p->names[i][len] = '\0';
+    return p->nVars++;
+}
+
+void freeProgram(struct Program *p) {
+    int i;
+    for (i = 0; i < p->nVars; i++) free(p->names[i]);
+    free(p->code);
+    p->code = NULL;
+    p->nVars = 0;
+}
+
+// Parse space separated postfix tokens of any length; returns 0 and
+// prints why on error
+int loadProgram(struct Program *p, const char *text) {
+    const char *tok;
+    int len, depth = 0, v, i;
+    i64 num;
+    p->code = (long long*)malloc((strlen(text) / 2 + 1) * sizeof(long long));
+    p->len = p->maxDepth = p->nVars = 0;
+    if (p->code == NULL) { printf("Out of memory\n"); return 0; }
+    for (;;) {
+        while (isspace((unsigned char)*text)) text++;
+        if (*text == '\0') break;
+        for (tok = text; *text && !isspace((unsigned char)*text); text++);
+        len = (int)(text - tok);
+        if (isdigit((unsigned char)tok[0])) {
+            for (num = 0, i = 0; i < len && isdigit((unsigned char)tok[i]); i++) {
+                if (num > (CODE_ARG_MAX - (tok[i] - '0')) / 10) { printf("Literal too large: %.*s\n", len, tok); return 0; }
+                num = num * 10 + (tok[i] - '0');
+            }
+            if (i < len) { printf("Invalid token: %.*s\n", len, tok); return 0; }
+            p->code[p->len++] = CODE(OP_NUM, num);
+            depth++;
+        }
+        else if (isalpha((unsigned char)tok[0]) || tok[0] == '_') {
+            if ((v = varIndex(p, tok, len)) < 0) { printf("Too many variables\n"); return 0; }
+            p->code[p->len++] = CODE(OP_VAR, v);
+            depth++;
+        }
+        else if (len == 1 && tok[0] == '~') {
+            if (depth < 1) { printf("Missing operand for ~\n"); return 0; }
+            p->code[p->len++] = CODE(OP_NEG, 0);
+        }
+        else {
+            const char *ops = "+-*/^", *s = strchr(ops, tok[0]);
+            if (s == NULL || len != 1) { printf("Invalid token: %.*s\n", len, tok); return 0; }
+            if (depth < 2) { printf("Missing operand for %c\n", tok[0]); return 0; }
+            p->code[p->len++] = CODE(OP_ADD + (s - ops), 0);
+            depth--;
+        }
+        if (depth > p->maxDepth) p->maxDepth = depth;
+    }
+    if (depth != 1) { printf("Program must leave exactly one value\n"); return 0; }
+    return 1;
+}
+
+// ---------- Block kernels ----------
+//
+// Integer arithmetic goes through u64 so that overflow wraps instead of
+// being undefined; the loops still vectorize.
+
+void fillI(i64 *restrict a, i64 v, int n) { int i; for (i = 0; i < n; i++) a[i] = v; }
+void addI(i64 *restrict a, const i64 *restrict b, int n) { int i; for (i = 0; i < n; i++) a[i] = (i64)((u64)a[i] + (u64)b[i]); }
+void subI(i64 *restrict a, const i64 *restrict b, int n) { int i; for (i = 0; i < n; i++) a[i] = (i64)((u64)a[i] - (u64)b[i]); }
+void mulI(i64 *restrict a, const i64 *restrict b, int n) { int i; for (i = 0; i < n; i++) a[i] = (i64)((u64)a[i] * (u64)b[i]); }
+void negI(i64 *restrict a, int n) { int i; for (i = 0; i < n; i++) a[i] = (i64)(0 - (u64)a[i]); }
+
+// Returns the first bad row in the block, or -1
+int divI(i64 *restrict a, const i64 *restrict b, int n) {
+    int i, bad = 0;
+    for (i = 0; i < n; i++) bad |= (b[i] == 0) | ((a[i] == (i64)(1ULL << 63)) & (b[i] == -1));
+    if (bad) {
+        for (i = 0; i < n; i++) if (b[i] == 0 || (a[i] == (i64)(1ULL << 63) && b[i] == -1)) return i;
+    }
+    for (i = 0; i < n; i++) a[i] /= b[i];
+    return -1;
+}
+
+i64 powScalarI(i64 base, i64 e) {
+    u64 r = 1, b = (u64)base;
+    if (e < 0) return base == 1 ? 1 : base == -1 ? (e & 1 ? -1 : 1) : 0;   // integer 1/base^-e
+    for (; e; e >>= 1, b *= b) if (e & 1) r *= b;
+    return (i64)r;
+}
+
+void powI(i64 *restrict a, const i64 *restrict b, int n) { int i; for (i = 0; i < n; i++) a[i] = powScalarI(a[i], b[i]); }
+
+void fillD(double *restrict a, double v, int n) { int i; for (i = 0; i < n; i++) a[i] = v; }
+void addD(double *restrict a, const double *restrict b, int n) { int i; for (i = 0; i < n; i++) a[i] += b[i]; }
+void subD(double *restrict a, const double *restrict b, int n) { int i; for (i = 0; i < n; i++) a[i] -= b[i]; }
+void mulD(double *restrict a, const double *restrict b, int n) { int i; for (i = 0; i < n; i++) a[i] *= b[i]; }
+void negD(double *restrict a, int n) { int i; for (i = 0; i < n; i++) a[i] = -a[i]; }
+void powD(double *restrict a, const double *restrict b, int n) { int i; for (i = 0; i < n; i++) a[i] = pow(a[i], b[i]); }
+
+int divD(double *restrict a, const double *restrict b, int n) {
+    int i, bad = 0;
+    for (i = 0; i < n; i++) bad |= b[i] == 0.0;
+    if (bad) {
+        for (i = 0; i < n; i++) if (b[i] == 0.0) return i;
+    }
+    for (i = 0; i < n; i++) a[i] /= b[i];
+    return -1;
+}
+
+// ---------- Block evaluators ----------
+
+// Evaluate rows [0, rows) into out. Returns -1, or the row where a
+// division failed (out is then only valid for earlier blocks).
+long evalBlocksI(struct Program *p, i64 **cols, long rows, i64 *out) {
+    i64 *stack = (i64*)malloc((size_t)p->maxDepth * BLOCK * sizeof(i64)), *a, *b;
+    long base;
+    int n, k, sp, bad;
+    long long w;
+    for (base = 0; base < rows; base += BLOCK) {
+        n = rows - base < BLOCK ? (int)(rows - base) : BLOCK;
+        for (k = 0, sp = 0; k < p->len; k++) {
+            w = p->code[k];
+            switch (CODE_OP(w)) {
+                case OP_NUM: fillI(stack + sp++ * BLOCK, CODE_ARG(w), n); break;
+                case OP_VAR: memcpy(stack + sp++ * BLOCK, cols[CODE_ARG(w)] + base, n * sizeof(i64)); break;
+                case OP_NEG: negI(stack + (sp - 1) * BLOCK, n); break;
+                default:   // binary: a op= b, where b is the top block
+                    a = stack + (--sp - 1) * BLOCK;
+                    b = a + BLOCK;
+                    switch (CODE_OP(w)) {
+                        case OP_ADD: addI(a, b, n); break;
+                        case OP_SUB: subI(a, b, n); break;
+                        case OP_MUL: mulI(a, b, n); break;
+                        case OP_POW: powI(a, b, n); break;
+                        case OP_DIV:
+                            if ((bad = divI(a, b, n)) >= 0) { free(stack); return base + bad; }
+                            break;
+                    }
+            }
+        }
+        memcpy(out + base, stack, n * sizeof(i64));
+    }
+    free(stack);
+    return -1;
+}
+
+long evalBlocksD(struct Program *p, double **cols, long rows, double *out) {
+    double *stack = (double*)malloc((size_t)p->maxDepth * BLOCK * sizeof(double)), *a, *b;
+    long base;
+    int n, k, sp, bad;
+    long long w;
+    for (base = 0; base < rows; base += BLOCK) {
+        n = rows - base < BLOCK ? (int)(rows - base) : BLOCK;
+        for (k = 0, sp = 0; k < p->len; k++) {
+            w = p->code[k];
+            switch (CODE_OP(w)) {
+                case OP_NUM: fillD(stack + sp++ * BLOCK, (double)CODE_ARG(w), n); break;
+                case OP_VAR: memcpy(stack + sp++ * BLOCK, cols[CODE_ARG(w)] + base, n * sizeof(double)); break;
+                case OP_NEG: negD(stack + (sp - 1) * BLOCK, n); break;
+                default:   // binary: a op= b, where b is the top block
+                    a = stack + (--sp - 1) * BLOCK;
+                    b = a + BLOCK;
+                    switch (CODE_OP(w)) {
+                        case OP_ADD: addD(a, b, n); break;
+                        case OP_SUB: subD(a, b, n); break;
+                        case OP_MUL: mulD(a, b, n); break;
+                        case OP_POW: powD(a, b, n); break;
+                        case OP_DIV:
+                            if ((bad = divD(a, b, n)) >= 0) { free(stack); return base + bad; }
+                            break;
+                    }
+            }
+        }
+        memcpy(out + base, stack, n * sizeof(double));
+    }
+    free(stack);
+    return -1;
+}
+
+// Row-at-a-time interpreter with the same semantics, for comparison
+long evalRowsI(struct Program *p, i64 **cols, long rows, i64 *out) {
+    i64 *stack = (i64*)malloc(p->maxDepth * sizeof(i64));
+    long r;
+    int k, sp;
+    for (r = 0; r < rows; r++) {
+        for (k = 0, sp = 0; k < p->len; k++) {
+            long long w = p->code[k];
+            i64 x = sp > 1 ? stack[sp - 2] : 0, y = sp > 0 ? stack[sp - 1] : 0;
+            switch (CODE_OP(w)) {
+                case OP_NUM: stack[sp++] = CODE_ARG(w); break;
+                case OP_VAR: stack[sp++] = cols[CODE_ARG(w)][r]; break;
+                case OP_NEG: stack[sp - 1] = (i64)(0 - (u64)y); break;
+                case OP_ADD: stack[--sp - 1] = (i64)((u64)x + (u64)y); break;
+                case OP_SUB: stack[--sp - 1] = (i64)((u64)x - (u64)y); break;
+                case OP_MUL: stack[--sp - 1] = (i64)((u64)x * (u64)y); break;
+                case OP_POW: stack[--sp - 1] = powScalarI(x, y); break;
+                case OP_DIV:
+                    if (y == 0 || (x == (i64)(1ULL << 63) && y == -1)) { free(stack); return r; }
+                    stack[--sp - 1] = x / y;
+                    break;
+            }
+        }
+        out[r] = stack[0];
+    }
+    free(stack);
+    return -1;
+}
+
+long evalRowsD(struct Program *p, double **cols, long rows, double *out) {
+    double *stack = (double*)malloc(p->maxDepth * sizeof(double));
+    long r;
+    int k, sp;
+    for (r = 0; r < rows; r++) {
+        for (k = 0, sp = 0; k < p->len; k++) {
+            long long w = p->code[k];
+            double x = sp > 1 ? stack[sp - 2] : 0, y = sp > 0 ? stack[sp - 1] : 0;
+            switch (CODE_OP(w)) {
+                case OP_NUM: stack[sp++] = (double)CODE_ARG(w); break;
+                case OP_VAR: stack[sp++] = cols[CODE_ARG(w)][r]; break;
+                case OP_NEG: stack[sp - 1] = -y; break;
+                case OP_ADD: stack[--sp - 1] = x + y; break;
+                case OP_SUB: stack[--sp - 1] = x - y; break;
+                case OP_MUL: stack[--sp - 1] = x * y; break;
+                case OP_POW: stack[--sp - 1] = pow(x, y); break;
+                case OP_DIV:
+                    if (y == 0.0) { free(stack); return r; }
+                    stack[--sp - 1] = x / y;
+                    break;
+            }
+        }
+        out[r] = stack[0];
+    }
+    free(stack);
+    return -1;
+}
+
+// ---------- Driver ----------
+
+// Random non-zero column data, one column per program variable
+void makeColumns(struct Program *p, long rows, i64 **ci, double **cd) {
+    int v;
+    long r;
+    unsigned s = 12345;
+    for (v = 0; v < p->nVars; v++) {
+        ci[v] = (i64*)malloc(rows * sizeof(i64));
+        cd[v] = (double*)malloc(rows * sizeof(double));
+        for (r = 0; r < rows; r++) {
+            s ^= s << 13; s ^= s >> 17; s ^= s << 5;
+            ci[v][r] = (i64)(s % 199) - 99;
+            if (ci[v][r] == 0) ci[v][r] = 1;
+            cd[v][r] = ci[v][r] / 4.0;
+        }
+    }
+}
+
+void freeColumns(struct Program *p, i64 **ci, double **cd) {
+    int v;
+    for (v = 0; v < p->nVars; v++) { free(ci[v]); free(cd[v]); }
+}
+
+void run(struct Program *p, long rows, int useDouble, int show) {
+    i64 *ci[MAX_VARS], *oi = NULL, *ri = NULL;
+    double *cd[MAX_VARS], *od = NULL, *rd = NULL;
+    long bad, badRows, r, diff = 0;
+    clock_t t;
+    double tBlock, tRow;
+    int v;
+    makeColumns(p, rows, ci, cd);
+    if (useDouble) { od = (double*)malloc(rows * sizeof(double)); rd = (double*)malloc(rows * sizeof(double)); }
+    else { oi = (i64*)malloc(rows * sizeof(i64)); ri = (i64*)malloc(rows * sizeof(i64)); }
+    t = clock();
+    bad = useDouble ? evalBlocksD(p, cd, rows, od) : evalBlocksI(p, ci, rows, oi);
+    tBlock = (double)(clock() - t) / CLOCKS_PER_SEC;
+    t = clock();
+    badRows = useDouble ? evalRowsD(p, cd, rows, rd) : evalRowsI(p, ci, rows, ri);
+    tRow = (double)(clock() - t) / CLOCKS_PER_SEC;
+    if (bad >= 0 || badRows >= 0) printf("Division by zero at row %ld (row-at-a-time: row %ld)\n", bad, badRows);
+    else {
+        for (r = 0; r < rows; r++) {
+            if (useDouble ? (od[r] != rd[r] && !(od[r] != od[r] && rd[r] != rd[r])) : oi[r] != ri[r]) diff++;
+        }
+        for (r = 0; r < rows && r < show; r++) {
+            printf("Row %ld:", r);
+            for (v = 0; v < p->nVars; v++) {
+                if (useDouble) printf(" %s=%g", p->names[v], cd[v][r]);
+                else printf(" %s=%lld", p->names[v], ci[v][r]);
+            }
+            if (useDouble) printf("  ->  %g\n", od[r]);
+            else printf("  ->  %lld\n", oi[r]);
+        }
+        printf("%ld rows (%s): blocks %.3f s, row-at-a-time %.3f s, %s\n", rows, useDouble ? "double" : "int64",
+               tBlock, tRow, diff ? "RESULTS DIFFER" : "results match");
+    }
+    freeColumns(p, ci, cd);
+    free(oi); free(ri); free(od); free(rd);
+}
+
+void main() {
+    struct Program p;
+    char line[1024];
+    int choice, useDouble = 0, loaded;
+    long rows;
+    clrscr();
+    loaded = loadProgram(&p, "a b * c 3 - a * 7 / + b 2 ^ -");
+    do {
+        printf("\nProgram type: %s\n1.Enter Postfix Program 2.Show Sample Rows 3.Benchmark 4.Toggle int64/double 5.Exit\nEnter choice: ",
+               useDouble ? "double" : "int64");
+        if (scanf("%d", &choice) != 1) break;
+        getchar();
+        switch (choice) {
+            case 1:
+                printf("Enter Postfix Expression (space separated, ~ = unary minus): ");
+                if (fgets(line, sizeof(line), stdin) == NULL) break;
+                freeProgram(&p);
+                loaded = loadProgram(&p, line);
+                if (loaded) printf("Loaded %d instructions, %d variables, stack depth %d\n", p.len, p.nVars, p.maxDepth);
+                break;
+            case 2:
+                if (loaded) run(&p, 10, useDouble, 10);
+                else printf("No program loaded\n");
+                break;
+            case 3:
+                printf("Enter number of rows: ");
+                scanf("%ld", &rows);
+                if (!loaded) printf("No program loaded\n");
+                else if (rows > 0) run(&p, rows, useDouble, 0);
+                break;
+            case 4: useDouble = !useDouble; break;
+            case 5: break;
+            default: printf("Invalid choice");
+        }
+    } while (choice != 5);
+    freeProgram(&p);
+    getch();
+}
@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Unbounded deque built from fixed-size blocks. A central map holds the
+// block pointers in order; only the map is ever reallocated, blocks never
+// move, so a pointer to an element stays valid while other elements are
+// added at either end. Emptied blocks go to a small cache, so a deque
+// that grows and shrinks around a steady size does no malloc/free.
+
+#define BLOCK 128        // elements per block (512 bytes)
+#define CACHE_BLOCKS 4
+
+struct Deque {
+    int **map;           // block pointers, used slots are [first, last]
+    int mapSize;
+    int first, last;     // first and last used map slots
+    int start;           // offset of the front element inside map[first]
+    long count;
+    int *cache[CACHE_BLOCKS];
+    int cached;
+    long mallocs;        // block allocations, for the churn benchmark
+};
+
+void dequeInit(struct Deque *d) {
+    d->mapSize = 8;
+    d->map = (int**)calloc(d->mapSize, sizeof(int*));
+    d->first = d->mapSize / 2;
+    d->last = d->first - 1;   // no blocks yet
+    d->start = 0;
+    d->count = 0;
+    d->cached = 0;
+    d->mallocs = 0;
+}
+
+int *getBlock(struct Deque *d) {
+    int *b;
+    if(d->cached > 0) return d->cache[--d->cached];
+    b = (int*)malloc(BLOCK * sizeof(int));
+    if(b == NULL) { printf("\nDeque is Full!"); exit(1); }
+    d->mallocs++;
+    return b;
+}
+
+void putBlock(struct Deque *d, int *b) {
+    if(d->cached < CACHE_BLOCKS) d->cache[d->cached++] = b;
+    else free(b);
+}
+
+// Make room for one more block slot at the front (atFront) or back.
+// Recentres the used slots in the map, doubling it when more than half full.
+void reserveSlot(struct Deque *d, int atFront) {
+    int used = d->last - d->first + 1, newSize = d->mapSize, newFirst, i;
+    int **m;
+    if(atFront ? d->first > 0 : d->last < d->mapSize - 1) return;
+    if(used * 2 >= d->mapSize) newSize = d->mapSize * 2;
+    m = (int**)calloc(newSize, sizeof(int*));
+    if(m == NULL) { printf("\nDeque is Full!"); exit(1); }
+    newFirst = (newSize - used) / 2;
+    for(i = 0; i < used; i++) m[newFirst + i] = d->map[d->first + i];
+    free(d->map);
+    d->map = m;
+    d->mapSize = newSize;
+    d->first = newFirst;
+    d->last = newFirst + used - 1;
+}
+
+// Reference to element i (0 = front), valid until that element is removed
+int *at(struct Deque *d, long i) {
+    long k = d->start + i;
+    return &d->map[d->first + k / BLOCK][k % BLOCK];
+}
+
+void addRear(struct Deque *d, int val) {
+    long end = d->start + d->count;   // slot just past the back element
+    if(d->last < d->first) {   // no blocks at all
+        reserveSlot(d, 0);
+        d->map[++d->last] = getBlock(d);
+        d->start = 0;
+        end = 0;
+    }
+    else if(end == (long)(d->last - d->first + 1) * BLOCK) {
+        reserveSlot(d, 0);
+        d->map[++d->last] = getBlock(d);
+    }
+    d->map[d->first + end / BLOCK][end % BLOCK] = val;
+    d->count++;
+}
+
+void addFront(struct Deque *d, int val) {
+    if(d->last < d->first) {
+        reserveSlot(d, 1);
+        d->map[--d->first] = getBlock(d);
+        d->last = d->first;
+        d->start = BLOCK;
+    }
+    else if(d->start == 0) {
+        reserveSlot(d, 1);
+        d->map[--d->first] = getBlock(d);
+        d->start = BLOCK;
+    }
+    d->start--;
+    d->map[d->first][d->start] = val;
+    d->count++;
+}
+
+int deleteFront(struct Deque *d, int *val) {
+    if(d->count == 0) return 0;
+    *val = d->map[d->first][d->start];
+    d->start++;
+    d->count--;
+    if(d->start == BLOCK || d->count == 0) {   // front block now empty
+        putBlock(d, d->map[d->first]);
+        d->map[d->first++] = NULL;
+        d->start = 0;
+        if(d->count == 0) {
+            while(d->first <= d->last) { putBlock(d, d->map[d->first]); d->map[d->first++] = NULL; }
+            d->first = d->mapSize / 2;
+            d->last = d->first - 1;
+        }
+    }
+    return 1;
+}
+
+int deleteRear(struct Deque *d, int *val) {
+    long end;
+    if(d->count == 0) return 0;
+    *val = *at(d, d->count - 1);
+    d->count--;
+    end = d->start + d->count;
+    if(d->count == 0) {
+        while(d->first <= d->last) { putBlock(d, d->map[d->first]); d->map[d->first++] = NULL; }
+        d->first = d->mapSize / 2;
+        d->last = d->first - 1;
+        d->start = 0;
+    }
+    else if(end <= (long)(d->last - d->first) * BLOCK) {   // back block now empty
+        putBlock(d, d->map[d->last]);
+        d->map[d->last--] = NULL;
+    }
+    return 1;
+}
+
+void display(struct Deque *d) {
+    long i;
+    if(d->count == 0) { printf("\nDeque is Empty!"); return; }
+    printf("\nDeque elements: ");
+    for(i = 0; i < d->count; i++) printf("%d ", *at(d, i));
+}
+
+void dequeFree(struct Deque *d) {
+    int i;
+    for(i = d->first; i <= d->last; i++) free(d->map[i]);
+    for(i = 0; i < d->cached; i++) free(d->cache[i]);
+    free(d->map);
+}
+
+// Churn around a steady size: after warm-up no blocks should be allocated
+void benchmark(long steady, long ops) {
+    struct Deque d;
+    long i, before;
+    int v;
+    clock_t t;
+    dequeInit(&d);
+    for(i = 0; i < steady; i++) addRear(&d, (int)i);
+    before = d.mallocs;
+    t = clock();
+    for(i = 0; i < ops; i++) {
+        if(i % 2) { addRear(&d, (int)i); deleteFront(&d, &v); }   // queue-like
+        else { addFront(&d, (int)i); deleteRear(&d, &v); }        // and the reverse
+    }
+    printf("\n%ld push/pop pairs around %ld elements: %.3f s, %ld block mallocs after warm-up",
+           ops, steady, (double)(clock() - t) / CLOCKS_PER_SEC, d.mallocs - before);
+    dequeFree(&d);
+}
+
+void main() {
+    struct Deque d;
+    int choice, val;
+    int *ref = NULL;
+    long i, n;
+    dequeInit(&d);
+    clrscr();
+    do {
+        printf("\n1.Add Rear 2.Add Front 3.Delete Rear 4.Delete Front 5.Display 6.Get By Index 7.Keep Reference 8.Show Reference 9.Churn Benchmark 10.Exit\nEnter choice: ");
+        scanf("%d",&choice);
+        switch(choice) {
+            case 1:
+                printf("Enter value: "); scanf("%d",&val);
+                addRear(&d, val); printf("\n%d added at rear", val);
+                break;
+            case 2:
+                printf("Enter value: "); scanf("%d",&val);
+                addFront(&d, val); printf("\n%d added at front", val);
+                break;
+            // A held reference dies with its element (its block may be freed)
+            case 3:
+                if(d.count > 0 && ref == at(&d, d.count - 1)) ref = NULL;
+                if(deleteRear(&d, &val)) printf("\n%d removed from rear", val);
+                else printf("\nDeque is Empty!");
+                break;
+            case 4:
+                if(d.count > 0 && ref == at(&d, 0)) ref = NULL;
+                if(deleteFront(&d, &val)) printf("\n%d removed from front", val);
+                else printf("\nDeque is Empty!");
+                break;
+            case 5: display(&d); break;
+            case 6:
+                printf("Enter index: "); scanf("%ld",&i);
+                if(i < 0 || i >= d.count) printf("\nIndex out of range");
+                else printf("\nElement at %ld: %d", i, *at(&d, i));
+                break;
+            case 7:
+                printf("Enter index: "); scanf("%ld",&i);
+                if(i < 0 || i >= d.count) printf("\nIndex out of range");
+                else { ref = at(&d, i); printf("\nHolding reference to %d", *ref); }
+                break;
+            case 8:
+                if(ref == NULL) printf("\nNo reference held (none taken, or its element was removed)");
+                else printf("\nReferenced element: %d", *ref);
+                break;
+            case 9:
+                printf("Enter steady size and operations: "); scanf("%ld %ld",&i,&n);
+                if(i > 0 && n > 0) benchmark(i, n);
+                break;
+            case 10: break;
+            default: printf("Invalid choice");
+        }
+    } while(choice!=10);
+    dequeFree(&d);
+    getch();
+}
@@ -1,15 +1,18 @@
 #include <stdio.h>
-#include <conio.h>
+#include <stdlib.h>
+#include "fast_io.h"
 
 void main() {
-    int arr[10], n, i, j, min, temp;
-    clrscr();
+    int *arr, n, i, j, min, temp;
+    startIO();
     
-    printf("Enter number of elements: ");
-    scanf("%d",&n);
+    prompt("Enter number of elements: ");
+    if(!readInt(&n) || n < 0) { writeStr("Invalid input\n"); endIO(); return; }
+    arr = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    if(arr == NULL) { writeStr("Out of memory\n"); endIO(); return; }
     
-    printf("Enter elements: ");
-    for(i=0;i<n;i++) scanf("%d",&arr[i]);
+    prompt("Enter elements: ");
+    if(!readInts(arr, n)) { writeStr("Invalid input\n"); free(arr); endIO(); return; }
     
     for(i=0;i<n-1;i++) {
         min=i;
@@ -18,7 +21,8 @@ void main() {
         temp=arr[i]; arr[i]=arr[min]; arr[min]=temp;
     }
     
-    printf("Sorted array: ");
-    for(i=0;i<n;i++) printf("%d ", arr[i]);
-    getch();
+    writeStr("Sorted array: ");
+    for(i=0;i<n;i++) { writeInt(arr[i]); writeChar(' '); }
+    free(arr);
+    endIO();
 }
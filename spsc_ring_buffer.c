@@ -0,0 +1,182 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+
+// Single-producer/single-consumer ring buffer. The size is a power of two
+// so indices wrap with a mask instead of % SIZE, and head/tail run freely
+// (count = tail - head). Each index sits on its own cache line next to the
+// owner's cached copy of the other side's index, so a side only reads the
+// shared line of the other when its cached copy says the ring is full/empty.
+
+#define CACHE_LINE 64
+
+struct Ring {
+    _Alignas(CACHE_LINE) _Atomic size_t head;   // written by the consumer
+    size_t cachedTail;                          // consumer's copy of tail
+    _Alignas(CACHE_LINE) _Atomic size_t tail;   // written by the producer
+    size_t cachedHead;                          // producer's copy of head
+    _Alignas(CACHE_LINE) int *buf;
+    size_t mask;
+};
+
+int ringInit(struct Ring *r, size_t size) {
+    size_t cap = 1;
+    while(cap < size) cap <<= 1;
+    r->buf = (int*)malloc(cap * sizeof(int));
+    if(r->buf == NULL) return 0;
+    r->mask = cap - 1;
+    atomic_init(&r->head, 0);
+    atomic_init(&r->tail, 0);
+    r->cachedTail = r->cachedHead = 0;
+    return 1;
+}
+
+// Producer: enqueue up to n values, returns how many fit
+size_t enqueueSpan(struct Ring *r, const int *vals, size_t n) {
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    size_t cap = r->mask + 1, room, i;
+    room = cap - (tail - r->cachedHead);
+    if(room < n) {
+        r->cachedHead = atomic_load_explicit(&r->head, memory_order_acquire);
+        room = cap - (tail - r->cachedHead);
+        if(n > room) n = room;
+    }
+    for(i = 0; i < n; i++) r->buf[(tail + i) & r->mask] = vals[i];
+    atomic_store_explicit(&r->tail, tail + n, memory_order_release);
+    return n;
+}
+
+// Consumer: dequeue up to n values, returns how many were available
+size_t dequeueSpan(struct Ring *r, int *out, size_t n) {
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    size_t avail, i;
+    avail = r->cachedTail - head;
+    if(avail < n) {
+        r->cachedTail = atomic_load_explicit(&r->tail, memory_order_acquire);
+        avail = r->cachedTail - head;
+        if(n > avail) n = avail;
+    }
+    for(i = 0; i < n; i++) out[i] = r->buf[(head + i) & r->mask];
+    atomic_store_explicit(&r->head, head + n, memory_order_release);
+    return n;
+}
+
+int enqueue(struct Ring *r, int val) {
+    return enqueueSpan(r, &val, 1) == 1;
+}
+
+int dequeue(struct Ring *r, int *val) {
+    return dequeueSpan(r, val, 1) == 1;
+}
+
+// Only safe while no other thread uses the ring
+void display(struct Ring *r) {
+    size_t i, head = atomic_load(&r->head), tail = atomic_load(&r->tail);
+    if(head == tail) { printf("Queue is empty"); return; }
+    printf("Queue elements: ");
+    for(i = head; i != tail; i++) printf("%d ", r->buf[i & r->mask]);
+}
+
+// Two-thread throughput test: the producer sends 0..n-1, the consumer
+// checks order and sums what it receives
+struct Bench {
+    struct Ring ring;
+    long n;
+    int batch;
+    long long sum;
+    long errors;
+};
+
+void *producer(void *arg) {
+    struct Bench *b = (struct Bench*)arg;
+    int *vals = (int*)malloc(b->batch * sizeof(int));
+    long sent = 0;
+    size_t k, i, put;
+    while(sent < b->n) {
+        k = b->n - sent < b->batch ? b->n - sent : b->batch;
+        for(i = 0; i < k; i++) vals[i] = (int)(sent + i);
+        i = 0;
+        while(i < k) {
+            put = enqueueSpan(&b->ring, vals + i, k - i);
+            if(put == 0) sched_yield();   // ring full, let the consumer run
+            i += put;
+        }
+        sent += k;
+    }
+    free(vals);
+    return NULL;
+}
+
+void *consumer(void *arg) {
+    struct Bench *b = (struct Bench*)arg;
+    int *vals = (int*)malloc(b->batch * sizeof(int));
+    long got = 0;
+    size_t k, i;
+    while(got < b->n) {
+        k = dequeueSpan(&b->ring, vals, b->batch);
+        if(k == 0) sched_yield();   // ring empty, let the producer run
+        for(i = 0; i < k; i++) {
+            if(vals[i] != (int)(got + i)) b->errors++;
+            b->sum += vals[i];
+        }
+        got += k;
+    }
+    free(vals);
+    return NULL;
+}
+
+void benchmark(long n, int batch, size_t size) {
+    struct Bench b;
+    pthread_t p, c;
+    struct timespec t0, t1;
+    double secs;
+    if(!ringInit(&b.ring, size)) { printf("Queue Overflow"); return; }
+    b.n = n; b.batch = batch; b.sum = 0; b.errors = 0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    pthread_create(&c, NULL, consumer, &b);
+    pthread_create(&p, NULL, producer, &b);
+    pthread_join(p, NULL);
+    pthread_join(c, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) * 1e-9;
+    printf("%ld items, batch %d: %.3f s, %.1f M items/s, %s\n", n, batch, secs, n / secs / 1e6,
+           b.errors == 0 && b.sum == (long long)n * (n - 1) / 2 ? "order OK" : "ORDER ERROR");
+    free(b.ring.buf);
+}
+
+void main() {
+    struct Ring q;
+    int choice, val, batch;
+    long n;
+    clrscr();
+    if(!ringInit(&q, 8)) { printf("Queue Overflow"); return; }
+    do {
+        printf("\n1.Enqueue 2.Dequeue 3.Display 4.Two-thread Benchmark 5.Exit\nEnter choice: ");
+        scanf("%d",&choice);
+        switch(choice) {
+            case 1:
+                printf("Enter value to enqueue: ");
+                scanf("%d",&val);
+                if(!enqueue(&q, val)) printf("Queue Overflow");
+                break;
+            case 2:
+                if(dequeue(&q, &val)) printf("Dequeued element: %d", val);
+                else printf("Queue Underflow");
+                break;
+            case 3: display(&q); break;
+            case 4:
+                printf("Enter number of items and batch size: ");
+                scanf("%ld %d",&n,&batch);
+                if(n > 0 && batch > 0) benchmark(n, batch, 1 << 16);
+                break;
+            case 5: break;
+            default: printf("Invalid choice");
+        }
+    } while(choice!=5);
+    free(q.buf);
+    getch();
+}
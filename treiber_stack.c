@@ -0,0 +1,369 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+// ---------- Mode 1: single-threaded growable stack ----------
+
+struct Stack {
+    int *items;
+    int top;        // index of top element, -1 when empty
+    int capacity;
+};
+
+void stackInit(struct Stack *s) {
+    s->items = NULL;
+    s->top = -1;
+    s->capacity = 0;
+}
+
+// Make room for n more elements, doubling so pushes are amortised O(1)
+void reserve(struct Stack *s, int n) {
+    int cap = s->capacity ? s->capacity : 8;
+    int *p;
+    if(s->top + 1 + n <= s->capacity) return;
+    while(cap < s->top + 1 + n) cap *= 2;
+    p = (int*)realloc(s->items, cap * sizeof(int));
+    if(p == NULL) { printf("Stack Overflow\n"); exit(1); }
+    s->items = p;
+    s->capacity = cap;
+}
+
+void push(struct Stack *s, int val) {
+    reserve(s, 1);
+    s->items[++s->top] = val;
+}
+
+int pop(struct Stack *s, int *val) {
+    if(s->top == -1) return 0;
+    *val = s->items[s->top--];
+    return 1;
+}
+
+// Push n values, vals[n-1] ends up on top
+void pushSpan(struct Stack *s, int *vals, int n) {
+    int i;
+    reserve(s, n);
+    for(i = 0; i < n; i++) s->items[s->top + 1 + i] = vals[i];
+    s->top += n;
+}
+
+// Pop up to n values in pop order, returns how many were popped
+int popSpan(struct Stack *s, int *out, int n) {
+    int i;
+    if(n > s->top + 1) n = s->top + 1;
+    for(i = 0; i < n; i++) out[i] = s->items[s->top - i];
+    s->top -= n;
+    return n;
+}
+
+void display(struct Stack *s) {
+    int i;
+    if(s->top == -1) { printf("Stack is empty"); return; }
+    printf("Stack elements: ");
+    for(i = s->top; i >= 0; i--) printf("%d ", s->items[i]);
+}
+
+// ---------- Mode 2: lock-free Treiber stack ----------
+//
+// Nodes come from a pool addressed by 32-bit index and are never returned
+// to the OS while the program runs, so a thread reading a node that was
+// popped meanwhile still reads valid memory. The stack top and the pool's
+// free list pack {tag, index} into one 64-bit word; every successful CAS
+// bumps the tag, which defeats ABA. The pool grows by adding segments of
+// doubling size: index i lives in segment floor(log2 i).
+
+#define SEGMENTS 32
+#define ELIM_SLOTS 16
+#define ELIM_SPINS 64
+
+struct CNode {
+    int value;
+    _Atomic uint32_t next;
+};
+
+_Atomic(struct CNode*) segment[SEGMENTS];
+_Atomic uint32_t nextIndex = 1;   // index 0 is the null link
+_Atomic uint64_t top = 0;         // {tag << 32 | index}
+_Atomic uint64_t freeTop = 0;
+_Atomic uint64_t elim[ELIM_SLOTS];   // {state << 32 | value}
+int useElimination = 1;
+
+#define INDEX(w)    ((uint32_t)(w))
+#define TAGGED(w, i)  ((((w) >> 32) + 1) << 32 | (i))
+#define SLOT_EMPTY   0
+#define SLOT_WAITING 1
+#define SLOT_TAKEN   2
+
+int segOf(uint32_t i) {
+    int s = 0;
+    while(i >> (s + 1)) s++;
+    return s;
+}
+
+struct CNode *node(uint32_t i) {
+    int s = segOf(i);
+    return &atomic_load(&segment[s])[i - (1u << s)];
+}
+
+// Pop a tagged list; returns the removed index or 0
+uint32_t taggedPop(_Atomic uint64_t *head) {
+    uint64_t old = atomic_load(head), nw;
+    while(INDEX(old) != 0) {
+        nw = TAGGED(old, atomic_load(&node(INDEX(old))->next));
+        if(atomic_compare_exchange_weak(head, &old, nw)) return INDEX(old);
+    }
+    return 0;
+}
+
+int taggedPush(_Atomic uint64_t *head, uint32_t i) {
+    uint64_t old = atomic_load(head);
+    atomic_store(&node(i)->next, INDEX(old));
+    return atomic_compare_exchange_weak(head, &old, TAGGED(old, i));
+}
+
+uint32_t allocNode() {
+    uint32_t i = taggedPop(&freeTop);
+    struct CNode *seg, *expected = NULL;
+    int s;
+    if(i != 0) return i;
+    i = atomic_fetch_add(&nextIndex, 1);
+    s = segOf(i);
+    if(atomic_load(&segment[s]) == NULL) {
+        seg = (struct CNode*)calloc((size_t)1 << s, sizeof(struct CNode));
+        if(seg == NULL) { printf("Stack Overflow\n"); exit(1); }
+        if(!atomic_compare_exchange_strong(&segment[s], &expected, seg)) free(seg);
+    }
+    return i;
+}
+
+void freeNode(uint32_t i) {
+    while(!taggedPush(&freeTop, i));
+}
+
+unsigned nextRand(unsigned *s) {
+    *s ^= *s << 13; *s ^= *s >> 17; *s ^= *s << 5;
+    return *s;
+}
+
+// Elimination: a push parks its value in a random slot for a short while;
+// a pop that finds it there takes it and neither touches the stack top.
+int elimPush(int val, unsigned *seed) {
+    _Atomic uint64_t *slot = &elim[nextRand(seed) % ELIM_SLOTS];
+    uint64_t expected = SLOT_EMPTY, mine = (uint64_t)SLOT_WAITING << 32 | (uint32_t)val;
+    int i;
+    if(!atomic_compare_exchange_strong(slot, &expected, mine)) return 0;
+    for(i = 0; i < ELIM_SPINS; i++)
+        if(atomic_load(slot) >> 32 == SLOT_TAKEN) { atomic_store(slot, SLOT_EMPTY); return 1; }
+    expected = mine;
+    if(atomic_compare_exchange_strong(slot, &expected, SLOT_EMPTY)) return 0;
+    atomic_store(slot, SLOT_EMPTY);   // taken just before we withdrew
+    return 1;
+}
+
+int elimPop(int *val, unsigned *seed) {
+    _Atomic uint64_t *slot = &elim[nextRand(seed) % ELIM_SLOTS];
+    uint64_t w = atomic_load(slot);
+    if(w >> 32 != SLOT_WAITING) return 0;
+    if(!atomic_compare_exchange_strong(slot, &w, (uint64_t)SLOT_TAKEN << 32 | (uint32_t)w)) return 0;
+    *val = (int)(uint32_t)w;
+    return 1;
+}
+
+void cpush(int val, unsigned *seed) {
+    uint32_t i = allocNode();
+    node(i)->value = val;
+    while(!taggedPush(&top, i)) {
+        if(useElimination && elimPush(val, seed)) { freeNode(i); return; }
+    }
+}
+
+int cpop(int *val, unsigned *seed) {
+    uint64_t old = atomic_load(&top), nw;
+    uint32_t i;
+    for(;;) {
+        i = INDEX(old);
+        if(i == 0) return 0;
+        nw = TAGGED(old, atomic_load(&node(i)->next));
+        if(atomic_compare_exchange_weak(&top, &old, nw)) break;
+        if(useElimination && elimPop(val, seed)) return 1;
+        old = atomic_load(&top);
+    }
+    *val = node(i)->value;
+    freeNode(i);
+    return 1;
+}
+
+void cstackReset() {
+    int s;
+    for(s = 0; s < SEGMENTS; s++) { free(atomic_load(&segment[s])); atomic_store(&segment[s], NULL); }
+    atomic_store(&nextIndex, 1);
+    atomic_store(&top, 0);
+    atomic_store(&freeTop, 0);
+    for(s = 0; s < ELIM_SLOTS; s++) atomic_store(&elim[s], SLOT_EMPTY);
+}
+
+// ---------- Stress test and benchmark ----------
+
+#define MAX_THREADS 64
+
+struct Work {
+    int tid, locked;
+    unsigned seed;
+    long ops;
+};
+
+long perThread;
+_Atomic unsigned char *seen;
+_Atomic int stopFlag;
+struct Stack lockedStack;
+pthread_mutex_t stackLock = PTHREAD_MUTEX_INITIALIZER;
+
+void markSeen(int v) {
+    atomic_fetch_add(&seen[v], 1);
+}
+
+void *stressWorker(void *arg) {
+    struct Work *w = (struct Work*)arg;
+    long i;
+    int v;
+    for(i = 0; i < perThread; i++) {
+        cpush(w->tid * perThread + i, &w->seed);
+        if(nextRand(&w->seed) % 2 && cpop(&v, &w->seed)) markSeen(v);
+    }
+    return NULL;
+}
+
+void stressTest(int threads, long ops) {
+    pthread_t th[MAX_THREADS];
+    struct Work w[MAX_THREADS];
+    long i, total = threads * ops, bad = 0;
+    int v;
+    unsigned seed = 1;
+    cstackReset();
+    perThread = ops;
+    seen = (_Atomic unsigned char*)calloc(total, 1);
+    for(i = 0; i < threads; i++) { w[i].tid = i; w[i].seed = 99991 * (i + 1); }
+    for(i = 0; i < threads; i++) pthread_create(&th[i], NULL, stressWorker, &w[i]);
+    for(i = 0; i < threads; i++) pthread_join(th[i], NULL);
+    while(cpop(&v, &seed)) markSeen(v);
+    for(i = 0; i < total; i++) if(seen[i] != 1) bad++;
+    printf("Stress test with %d threads: %s (%ld of %ld values lost or duplicated)\n",
+           threads, bad ? "FAILED" : "PASSED", bad, total);
+    free((void*)seen);
+    cstackReset();
+}
+
+void *benchWorker(void *arg) {
+    struct Work *w = (struct Work*)arg;
+    int v;
+    while(!atomic_load_explicit(&stopFlag, memory_order_relaxed)) {
+        if(w->locked) {
+            pthread_mutex_lock(&stackLock); push(&lockedStack, w->tid); pthread_mutex_unlock(&stackLock);
+            pthread_mutex_lock(&stackLock); pop(&lockedStack, &v); pthread_mutex_unlock(&stackLock);
+        } else {
+            cpush(w->tid, &w->seed);
+            cpop(&v, &w->seed);
+        }
+        w->ops += 2;
+    }
+    return NULL;
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void benchmark(double seconds) {
+    pthread_t th[MAX_THREADS];
+    struct Work w[MAX_THREADS];
+    struct timespec pause;
+    int threads, mode, i;
+    long total;
+    double t;
+    pause.tv_sec = (time_t)seconds;
+    pause.tv_nsec = (long)((seconds - pause.tv_sec) * 1e9);
+    stackInit(&lockedStack);
+    printf("Threads   Treiber   +Elimination   Mutex   (Mops/s)\n");
+    for(threads = 1; threads <= MAX_THREADS; threads *= 2) {
+        printf("%7d", threads);
+        for(mode = 0; mode < 3; mode++) {
+            cstackReset();
+            useElimination = mode == 1;
+            atomic_store(&stopFlag, 0);
+            for(i = 0; i < threads; i++) { w[i].tid = i; w[i].locked = mode == 2; w[i].seed = 31 * (i + 1); w[i].ops = 0; }
+            t = now();
+            for(i = 0; i < threads; i++) pthread_create(&th[i], NULL, benchWorker, &w[i]);
+            nanosleep(&pause, NULL);
+            atomic_store(&stopFlag, 1);
+            for(i = 0; i < threads; i++) pthread_join(th[i], NULL);
+            t = now() - t;
+            for(total = 0, i = 0; i < threads; i++) total += w[i].ops;
+            printf("%10.2f", total / t / 1e6);
+        }
+        printf("\n");
+    }
+    useElimination = 1;
+    cstackReset();
+    free(lockedStack.items);
+}
+
+void main() {
+    struct Stack s;
+    int choice, val, n, i, threads;
+    int *buf;
+    long ops;
+    stackInit(&s);
+    clrscr();
+    do {
+        printf("\n1.Push 2.Pop 3.Display 4.Push Span 5.Pop Span 6.Concurrent Stress Test 7.Benchmark 8.Exit\nEnter choice: ");
+        scanf("%d",&choice);
+        switch(choice) {
+            case 1:
+                printf("Enter value to push: ");
+                scanf("%d",&val);
+                push(&s, val);
+                break;
+            case 2:
+                if(pop(&s, &val)) printf("Popped element: %d", val);
+                else printf("Stack Underflow");
+                break;
+            case 3: display(&s); break;
+            case 4:
+                printf("Enter count and values: ");
+                scanf("%d",&n);
+                if(n <= 0) break;
+                buf = (int*)malloc(n * sizeof(int));
+                for(i = 0; i < n; i++) scanf("%d",&buf[i]);
+                pushSpan(&s, buf, n);
+                free(buf);
+                break;
+            case 5:
+                printf("Enter count: ");
+                scanf("%d",&n);
+                if(n <= 0) break;
+                buf = (int*)malloc(n * sizeof(int));
+                n = popSpan(&s, buf, n);
+                if(n == 0) printf("Stack Underflow");
+                else { printf("Popped elements: "); for(i = 0; i < n; i++) printf("%d ", buf[i]); }
+                free(buf);
+                break;
+            case 6:
+                printf("Enter threads (1-64) and pushes per thread: ");
+                scanf("%d %ld",&threads,&ops);
+                if(threads < 1 || threads > MAX_THREADS) printf("Invalid thread count");
+                else stressTest(threads, ops);
+                break;
+            case 7: benchmark(0.5); break;
+            case 8: break;
+            default: printf("Invalid choice");
+        }
+    } while(choice!=8);
+    free(s.items);
+    getch();
+}
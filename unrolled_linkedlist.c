@@ -0,0 +1,242 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Each node holds up to CAP elements so that one node spans two cache lines
+// (8 byte next + 4 byte count + 29*4 byte data = 128 bytes on 64-bit).
+#define CAP 29
+#define MIN_FILL (CAP / 2)   // nodes below this fill are merged/rebalanced
+
+struct UNode {
+    struct UNode *next;
+    int count;
+    int data[CAP];
+};
+
+struct UNode *head = NULL, *tail = NULL;
+
+struct UNode *newUNode() {
+    struct UNode *n = (struct UNode*)malloc(sizeof(struct UNode));
+    if(n == NULL) { printf("OVERFLOW\n"); exit(1); }
+    n->next = NULL;
+    n->count = 0;
+    return n;
+}
+
+// Split a full node in half, the upper half moves to a new node after it
+void splitNode(struct UNode *node) {
+    struct UNode *n = newUNode();
+    int i, half = node->count / 2;
+    for(i = half; i < node->count; i++) n->data[i - half] = node->data[i];
+    n->count = node->count - half;
+    node->count = half;
+    n->next = node->next;
+    node->next = n;
+    if(tail == node) tail = n;
+}
+
+// Insert val at index idx inside node, splitting first if the node is full
+void insertInNode(struct UNode *node, int idx, int val) {
+    int i;
+    if(node->count == CAP) {
+        splitNode(node);
+        if(idx > node->count) { idx -= node->count; node = node->next; }
+    }
+    for(i = node->count; i > idx; i--) node->data[i] = node->data[i - 1];
+    node->data[idx] = val;
+    node->count++;
+}
+
+// Unlink an empty node (prev is NULL when node is head)
+void unlinkNode(struct UNode *prev, struct UNode *node) {
+    if(prev == NULL) head = node->next;
+    else prev->next = node->next;
+    if(tail == node) tail = prev;
+    free(node);
+}
+
+// Keep fill factor: an underfull node borrows from or merges with its successor
+void rebalance(struct UNode *prev, struct UNode *node) {
+    struct UNode *nx = node->next;
+    int i, move;
+    if(node->count == 0) { unlinkNode(prev, node); return; }
+    if(node->count >= MIN_FILL || nx == NULL) return;
+    if(node->count + nx->count <= CAP) {   // merge successor into node
+        for(i = 0; i < nx->count; i++) node->data[node->count + i] = nx->data[i];
+        node->count += nx->count;
+        node->next = nx->next;
+        if(tail == nx) tail = node;
+        free(nx);
+    } else {   // borrow enough elements to reach MIN_FILL
+        move = MIN_FILL - node->count;
+        for(i = 0; i < move; i++) node->data[node->count + i] = nx->data[i];
+        node->count += move;
+        for(i = move; i < nx->count; i++) nx->data[i - move] = nx->data[i];
+        nx->count -= move;
+    }
+}
+
+// Remove element idx from node
+void removeFromNode(struct UNode *prev, struct UNode *node, int idx) {
+    int i;
+    for(i = idx; i < node->count - 1; i++) node->data[i] = node->data[i + 1];
+    node->count--;
+    rebalance(prev, node);
+}
+
+// Insertion
+void insertFront(int val) {
+    if(head == NULL) head = tail = newUNode();
+    insertInNode(head, 0, val);
+}
+
+void insertEnd(int val) {
+    if(tail == NULL) head = tail = newUNode();
+    insertInNode(tail, tail->count, val);
+}
+
+void insertAfter(int val, int after) {
+    struct UNode *temp;
+    int i;
+    for(temp = head; temp != NULL; temp = temp->next)
+        for(i = 0; i < temp->count; i++)
+            if(temp->data[i] == after) { insertInNode(temp, i + 1, val); return; }
+    printf("Element %d not found\n", after);
+}
+
+// Deletion
+void deleteFront() {
+    if(head == NULL) { printf("List is empty\n"); return; }
+    printf("Deleted element: %d\n", head->data[0]);
+    removeFromNode(NULL, head, 0);
+}
+
+void deleteEnd() {
+    struct UNode *prev = NULL;
+    if(head == NULL) { printf("List is empty\n"); return; }
+    if(head != tail)
+        for(prev = head; prev->next != tail; prev = prev->next);
+    printf("Deleted element: %d\n", tail->data[tail->count - 1]);
+    tail->count--;
+    if(tail->count == 0) unlinkNode(prev, tail);
+}
+
+void deleteValue(int val) {
+    struct UNode *prev = NULL, *temp;
+    int i;
+    if(head == NULL) { printf("List is empty\n"); return; }
+    for(temp = head; temp != NULL; prev = temp, temp = temp->next)
+        for(i = 0; i < temp->count; i++)
+            if(temp->data[i] == val) {
+                removeFromNode(prev, temp, i);
+                printf("Deleted %d\n", val);
+                return;
+            }
+    printf("Element %d not found\n", val);
+}
+
+// Search: returns 1-based position or 0, scanning each node's array linearly
+int findPos(int val) {
+    struct UNode *temp;
+    int i, base = 0;
+    for(temp = head; temp != NULL; temp = temp->next) {
+        for(i = 0; i < temp->count; i++)
+            if(temp->data[i] == val) return base + i + 1;
+        base += temp->count;
+    }
+    return 0;
+}
+
+void search(int val) {
+    int pos = findPos(val);
+    if(pos) printf("Element %d found at position %d\n", val, pos);
+    else printf("Element %d not found\n", val);
+}
+
+// Display
+void display() {
+    struct UNode *temp;
+    int i;
+    if(head == NULL) { printf("List is empty\n"); return; }
+    printf("Linked list: ");
+    for(temp = head; temp != NULL; temp = temp->next)
+        for(i = 0; i < temp->count; i++) printf("%d ", temp->data[i]);
+    printf("\n");
+}
+
+void stats() {
+    struct UNode *temp;
+    int nodes = 0, elems = 0;
+    for(temp = head; temp != NULL; temp = temp->next) { nodes++; elems += temp->count; }
+    printf("Elements: %d, Nodes: %d, Fill: %.1f%%\n", elems, nodes,
+           nodes ? 100.0 * elems / (nodes * CAP) : 0.0);
+}
+
+// Benchmark: sequential scan of an unrolled list vs a one-int-per-node list
+struct Node {
+    int data;
+    struct Node *next;
+};
+
+void benchmark(int n, int rounds) {
+    struct Node **nodes, *plain = NULL, *p;
+    struct UNode *u;
+    long long sum1 = 0, sum2 = 0;
+    clock_t t;
+    int i, j, r;
+    double tPlain, tUnrolled;
+
+    // Link plain nodes in shuffled order to mimic an aged, fragmented heap
+    nodes = (struct Node**)malloc(n * sizeof(struct Node*));
+    for(i = 0; i < n; i++) { nodes[i] = (struct Node*)malloc(sizeof(struct Node)); nodes[i]->data = i; }
+    for(i = n - 1; i > 0; i--) { j = rand() % (i + 1); p = nodes[i]; nodes[i] = nodes[j]; nodes[j] = p; }
+    for(i = 0; i < n; i++) { nodes[i]->next = plain; plain = nodes[i]; }
+    for(i = 0; i < n; i++) insertEnd(i);
+
+    t = clock();
+    for(r = 0; r < rounds; r++)
+        for(p = plain; p != NULL; p = p->next) sum1 += p->data;
+    tPlain = (double)(clock() - t) / CLOCKS_PER_SEC;
+
+    t = clock();
+    for(r = 0; r < rounds; r++)
+        for(u = head; u != NULL; u = u->next)
+            for(i = 0; i < u->count; i++) sum2 += u->data[i];
+    tUnrolled = (double)(clock() - t) / CLOCKS_PER_SEC;
+
+    printf("Plain list:    %.3f s (sum %lld)\n", tPlain, sum1);
+    printf("Unrolled list: %.3f s (sum %lld)\n", tUnrolled, sum2);
+    if(tUnrolled > 0) printf("Speedup: %.1fx\n", tPlain / tUnrolled);
+
+    for(i = 0; i < n; i++) free(nodes[i]);
+    free(nodes);
+    while(head != NULL) { u = head; head = head->next; free(u); }
+    tail = NULL;
+}
+
+void main() {
+    int choice, val, after, n;
+    clrscr();
+    do {
+        printf("\n===== Unrolled Linked List Menu =====\n");
+        printf("1. Insert Front\n2. Insert End\n3. Insert After\n4. Delete Front\n5. Delete End\n6. Delete Value\n7. Search\n8. Display\n9. Stats\n10. Benchmark (clears list)\n11. Exit\n");
+        printf("Enter your choice: ");
+        scanf("%d",&choice);
+        switch(choice) {
+            case 1: printf("Enter value: "); scanf("%d",&val); insertFront(val); break;
+            case 2: printf("Enter value: "); scanf("%d",&val); insertEnd(val); break;
+            case 3: printf("Enter value and after element: "); scanf("%d %d",&val,&after); insertAfter(val, after); break;
+            case 4: deleteFront(); break;
+            case 5: deleteEnd(); break;
+            case 6: printf("Enter value to delete: "); scanf("%d",&val); deleteValue(val); break;
+            case 7: printf("Enter value to search: "); scanf("%d",&val); search(val); break;
+            case 8: display(); break;
+            case 9: stats(); break;
+            case 10: printf("Enter number of elements: "); scanf("%d",&n); benchmark(n, 20); break;
+            case 11: break;
+            default: printf("Invalid choice\n");
+        }
+    } while(choice != 11);
+    getch();
+}
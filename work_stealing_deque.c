@@ -0,0 +1,331 @@
+#include <stdio.h>
+#include <conio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <time.h>
+
+// Chase-Lev work-stealing deque. The owning thread pushes and pops at the
+// bottom without locks; other threads steal from the top with one CAS.
+// Only a race for the very last element needs a CAS by the owner.
+// When the array fills up the owner copies it into one twice as large.
+// Thieves may still be reading the old array, so it is kept on a retired
+// list and freed with the deque; the retired arrays total less than the
+// live one, so this costs at most 2x memory.
+
+#define EMPTY   INT64_MIN
+#define ABORT   (INT64_MIN + 1)
+
+struct Array {
+    struct Array *retired;   // older, smaller arrays
+    long size;               // power of two
+    _Atomic int64_t buf[1];
+};
+
+struct Deque {
+    _Alignas(64) _Atomic long top;
+    _Alignas(64) _Atomic long bottom;
+    _Atomic(struct Array*) array;
+};
+
+struct Array *newArray(long size, struct Array *retired) {
+    struct Array *a = (struct Array*)malloc(sizeof(struct Array) + (size - 1) * sizeof(int64_t));
+    if(a == NULL) { printf("\nDeque is Full!"); exit(1); }
+    a->size = size;
+    a->retired = retired;
+    return a;
+}
+
+void dequeInit(struct Deque *d, long size) {
+    atomic_init(&d->top, 0);
+    atomic_init(&d->bottom, 0);
+    atomic_init(&d->array, newArray(size, NULL));
+}
+
+void dequeFree(struct Deque *d) {
+    struct Array *a = atomic_load(&d->array), *r;
+    while(a != NULL) { r = a->retired; free(a); a = r; }
+}
+
+struct Array *grow(struct Deque *d, struct Array *a, long t, long b) {
+    struct Array *n = newArray(a->size * 2, a);
+    long i;
+    for(i = t; i < b; i++)
+        atomic_store_explicit(&n->buf[i & (n->size - 1)],
+            atomic_load_explicit(&a->buf[i & (a->size - 1)], memory_order_relaxed), memory_order_relaxed);
+    atomic_store_explicit(&d->array, n, memory_order_release);
+    return n;
+}
+
+// Owner only
+void pushBottom(struct Deque *d, int64_t x) {
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    long t = atomic_load_explicit(&d->top, memory_order_acquire);
+    struct Array *a = atomic_load_explicit(&d->array, memory_order_relaxed);
+    if(b - t > a->size - 1) a = grow(d, a, t, b);
+    atomic_store_explicit(&a->buf[b & (a->size - 1)], x, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+}
+
+// Owner only: returns EMPTY if there was nothing to take
+int64_t popBottom(struct Deque *d) {
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    struct Array *a = atomic_load_explicit(&d->array, memory_order_relaxed);
+    long t;
+    int64_t x;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    t = atomic_load_explicit(&d->top, memory_order_relaxed);
+    if(t > b) {   // was empty
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return EMPTY;
+    }
+    x = atomic_load_explicit(&a->buf[b & (a->size - 1)], memory_order_relaxed);
+    if(t == b) {   // last element: race thieves for it
+        if(!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                memory_order_seq_cst, memory_order_relaxed)) x = EMPTY;
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    }
+    return x;
+}
+
+// Any thread: returns EMPTY, ABORT (lost a race, may retry) or the value
+int64_t steal(struct Deque *d) {
+    long t = atomic_load_explicit(&d->top, memory_order_acquire), b;
+    struct Array *a;
+    int64_t x;
+    atomic_thread_fence(memory_order_seq_cst);
+    b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if(t >= b) return EMPTY;
+    a = atomic_load_explicit(&d->array, memory_order_acquire);
+    x = atomic_load_explicit(&a->buf[t & (a->size - 1)], memory_order_relaxed);
+    if(!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+            memory_order_seq_cst, memory_order_relaxed)) return ABORT;
+    return x;
+}
+
+// Only safe while no thief runs
+void display(struct Deque *d) {
+    long i, t = atomic_load(&d->top), b = atomic_load(&d->bottom);
+    struct Array *a = atomic_load(&d->array);
+    if(t >= b) { printf("\nDeque is Empty!"); return; }
+    printf("\nDeque elements (top to bottom): ");
+    for(i = t; i < b; i++) printf("%lld ", (long long)atomic_load(&a->buf[i & (a->size - 1)]));
+}
+
+// ---------- Stress test: one owner, several thieves ----------
+
+#define MAX_THREADS 64
+
+struct Deque stressDeque;
+_Atomic unsigned char *taken;
+_Atomic int ownerDone;
+
+void *thief(void *arg) {
+    int64_t x;
+    (void)arg;
+    for(;;) {
+        x = steal(&stressDeque);
+        if(x >= 0) atomic_fetch_add(&taken[x], 1);
+        else if(x == EMPTY && atomic_load(&ownerDone)) break;
+        else if(x == EMPTY) sched_yield();
+    }
+    return NULL;
+}
+
+void stressTest(int thieves, long n) {
+    pthread_t th[MAX_THREADS];
+    long i, bad = 0;
+    int64_t x;
+    int k;
+    dequeInit(&stressDeque, 2);   // tiny, so the array grows under contention
+    taken = (_Atomic unsigned char*)calloc(n, 1);
+    atomic_store(&ownerDone, 0);
+    for(k = 0; k < thieves; k++) pthread_create(&th[k], NULL, thief, NULL);
+    for(i = 0; i < n; i++) {
+        pushBottom(&stressDeque, i);
+        if(i % 3 == 0 && (x = popBottom(&stressDeque)) != EMPTY) atomic_fetch_add(&taken[x], 1);
+    }
+    while((x = popBottom(&stressDeque)) != EMPTY) atomic_fetch_add(&taken[x], 1);
+    atomic_store(&ownerDone, 1);
+    for(k = 0; k < thieves; k++) pthread_join(th[k], NULL);
+    for(i = 0; i < n; i++) if(taken[i] != 1) bad++;
+    printf("\nStress test with %d thieves: %s (%ld of %ld items lost or duplicated)",
+           thieves, bad ? "FAILED" : "PASSED", bad, n);
+    free((void*)taken);
+    dequeFree(&stressDeque);
+}
+
+// ---------- Parallel quicksort scheduled on per-worker deques ----------
+//
+// A task is a range [lo, hi) packed into one int64. A worker partitions its
+// range, pushes one half for others to steal and keeps working on the
+// other; ranges below CUTOFF are sorted sequentially.
+
+#define CUTOFF 4096
+#define SMALL 32
+#define PACK(lo, hi)  ((int64_t)(lo) << 32 | (uint32_t)(hi))
+
+struct Deque workers[MAX_THREADS];
+int *data;
+int nWorkers;
+_Atomic long pending;   // tasks pushed or running, not yet finished
+
+void insertionSort(int *a, long lo, long hi) {
+    long i, j;
+    int key;
+    for(i = lo + 1; i < hi; i++) {
+        key = a[i];
+        for(j = i - 1; j >= lo && a[j] > key; j--) a[j + 1] = a[j];
+        a[j + 1] = key;
+    }
+}
+
+long partition(int *a, long lo, long hi) {
+    long mid = lo + (hi - lo) / 2, i = lo, j = hi - 1;
+    int pivot, tmp;
+    // median of three
+    if(a[mid] < a[lo]) { tmp = a[mid]; a[mid] = a[lo]; a[lo] = tmp; }
+    if(a[j] < a[lo]) { tmp = a[j]; a[j] = a[lo]; a[lo] = tmp; }
+    if(a[j] < a[mid]) { tmp = a[j]; a[j] = a[mid]; a[mid] = tmp; }
+    pivot = a[mid];
+    for(;;) {
+        while(a[i] < pivot) i++;
+        while(a[j] > pivot) j--;
+        if(i >= j) return j + 1;
+        tmp = a[i]; a[i] = a[j]; a[j] = tmp;
+        i++; j--;
+    }
+}
+
+void seqSort(int *a, long lo, long hi) {
+    long p;
+    while(hi - lo > SMALL) {
+        p = partition(a, lo, hi);
+        if(p - lo < hi - p) { seqSort(a, lo, p); lo = p; }
+        else { seqSort(a, p, hi); hi = p; }
+    }
+    insertionSort(a, lo, hi);
+}
+
+void runTask(struct Deque *own, long lo, long hi) {
+    long p;
+    while(hi - lo > CUTOFF) {
+        p = partition(data, lo, hi);
+        atomic_fetch_add(&pending, 1);
+        pushBottom(own, PACK(p, hi));
+        hi = p;
+    }
+    seqSort(data, lo, hi);
+    atomic_fetch_sub(&pending, 1);
+}
+
+unsigned nextRand(unsigned *s) {
+    *s ^= *s << 13; *s ^= *s >> 17; *s ^= *s << 5;
+    return *s;
+}
+
+void *sortWorker(void *arg) {
+    int id = (int)(intptr_t)arg;
+    unsigned seed = 2166136261u ^ id;
+    int64_t x;
+    while(atomic_load(&pending) > 0) {
+        x = popBottom(&workers[id]);
+        if(x == EMPTY || x == ABORT) {
+            x = steal(&workers[nextRand(&seed) % nWorkers]);
+            if(x == EMPTY || x == ABORT) { sched_yield(); continue; }
+        }
+        runTask(&workers[id], x >> 32, (uint32_t)x);
+    }
+    return NULL;
+}
+
+int cmpInt(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void parallelSort(long n, int threads) {
+    pthread_t th[MAX_THREADS];
+    int *copy;
+    long i;
+    int ok = 1;
+    double t;
+    data = (int*)malloc(n * sizeof(int));
+    copy = (int*)malloc(n * sizeof(int));
+    for(i = 0; i < n; i++) copy[i] = data[i] = rand();
+    nWorkers = threads;
+    for(i = 0; i < threads; i++) dequeInit(&workers[i], 64);
+
+    t = now();
+    atomic_store(&pending, 1);
+    pushBottom(&workers[0], PACK(0, n));
+    for(i = 0; i < threads; i++) pthread_create(&th[i], NULL, sortWorker, (void*)(intptr_t)i);
+    for(i = 0; i < threads; i++) pthread_join(th[i], NULL);
+    printf("\nWork-stealing quicksort, %d threads: %.3f s", threads, now() - t);
+
+    t = now();
+    qsort(copy, n, sizeof(int), cmpInt);
+    printf("\nqsort, 1 thread:                   %.3f s", now() - t);
+    for(i = 0; i < n; i++) if(data[i] != copy[i]) { ok = 0; break; }
+    printf("\nResult %s", ok ? "matches qsort" : "DIFFERS from qsort");
+
+    for(i = 0; i < threads; i++) dequeFree(&workers[i]);
+    free(data);
+    free(copy);
+}
+
+void main() {
+    struct Deque d;
+    int choice, threads;
+    long val, n;
+    int64_t x;
+    dequeInit(&d, 4);
+    clrscr();
+    do {
+        printf("\n1.Push Bottom 2.Pop Bottom 3.Steal Top 4.Display 5.Stress Test 6.Parallel Sort 7.Exit\nEnter choice: ");
+        scanf("%d",&choice);
+        switch(choice) {
+            case 1:
+                printf("Enter value: ");
+                scanf("%ld",&val);
+                if(val < 0) printf("\nOnly non-negative values are stored");
+                else { pushBottom(&d, val); printf("\n%ld added at bottom", val); }
+                break;
+            case 2:
+                if((x = popBottom(&d)) == EMPTY) printf("\nDeque is Empty!");
+                else printf("\n%lld removed from bottom", (long long)x);
+                break;
+            case 3:
+                if((x = steal(&d)) < 0) printf("\nDeque is Empty!");
+                else printf("\n%lld stolen from top", (long long)x);
+                break;
+            case 4: display(&d); break;
+            case 5:
+                printf("Enter thieves (1-64) and items: ");
+                scanf("%d %ld",&threads,&n);
+                if(threads < 1 || threads > MAX_THREADS || n < 1) printf("Invalid input");
+                else stressTest(threads, n);
+                break;
+            case 6:
+                printf("Enter number of elements and threads (1-64): ");
+                scanf("%ld %d",&n,&threads);
+                if(threads < 1 || threads > MAX_THREADS || n < 1 || n > INT32_MAX) printf("Invalid input");
+                else parallelSort(n, threads);
+                break;
+            case 7: break;
+            default: printf("Invalid choice");
+        }
+    } while(choice!=7);
+    dequeFree(&d);
+    getch();
+}